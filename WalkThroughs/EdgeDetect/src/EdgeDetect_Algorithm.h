@@ -45,21 +45,48 @@ class EdgeDetect_Algorithm
 {
   // Define some "constants" for use in algorithm
   enum {
-    imageWidth  = 1296,
-    imageHeight =  864
+    defaultWidth  = 1296,
+    defaultHeight =  864
   };
 
+  // Image size, defaults to the constants above
+  int imageWidth;
+  int imageHeight;
+
+  // Run time kernel coefficients, edgeKernel is used until setKernel
+  bool progKernel;
+  int  kernel[3];
+
 public:
   // Constructor
-  EdgeDetect_Algorithm() {}
+  EdgeDetect_Algorithm(int width = defaultWidth, int height = defaultHeight)
+    : imageWidth(width), imageHeight(height), progKernel(false) {}
+
+  //--------------------------------------------------------------------------
+  // Function: setKernel
+  //   Replace edgeKernel by the coefficients {k0, k1, k2}, applied as
+  //   pix2*k0 + pix1*k1 + pix0*k2 like the programmable kernel designs
+  void setKernel(int k0, int k1, int k2)
+  {
+    progKernel = true;
+    kernel[0] = k0;
+    kernel[1] = k1;
+    kernel[2] = k2;
+  }
 
   //--------------------------------------------------------------------------
   // Function: run
   //   Top interface for data in/out of class. Combines vertical and 
-  //   horizontal derivative and magnitude/angle computation.
-  void run(unsigned char *dat_in,  // image data (streamed in by pixel)
-           double        *magn,    // magnitude output
-           double        *angle)   // angle output
+  //   horizontal derivative and magnitude/angle computation. mask is an
+  //   edgeOutputs value selecting magnitude, angle or both, an output not in
+  //   it may be NULL. The angle of pixels with a magnitude below magThresh
+  //   is not computed and is written as 0, which skips most of the atan2
+  //   calls of a thresholded pipeline.
+  void run(unsigned char *dat_in,    // image data (streamed in by pixel)
+           double        *magn,      // magnitude output
+           double        *angle,     // angle output
+           int            mask,      // outputs to compute
+           double         magThresh = 0) // angle threshold
   {
     // allocate buffers for image data
     double *dy = (double *)malloc(imageHeight*imageWidth*sizeof(double));
@@ -67,12 +94,24 @@ public:
 
     verticalDerivative(dat_in, dy);
     horizontalDerivative(dat_in, dx);
-    magnitudeAngle(dx, dy, magn, angle);
+    magnitudeAngle(dx, dy, magn, angle, mask, magThresh);
 
     free(dy);
     free(dx);
   }
 
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Outputs chosen at build time, same interface as the bit-accurate
+  //   models. Forwards to the run time selection above.
+  template <int outputs = edgeBoth>
+  void run(unsigned char *dat_in,  // image data (streamed in by pixel)
+           double        *magn,    // magnitude output
+           double        *angle)   // angle output
+  {
+    run(dat_in, magn, angle, outputs);
+  }
+
   //--------------------------------------------------------------------------
   // Function: verticalDerivative
   //   Compute the vertical derivative on the input data
@@ -82,9 +121,9 @@ public:
     for (int y = 0; y < imageHeight; y++) {
       for (int x = 0; x < imageWidth; x++) {
         *(dy + y * imageWidth + x) =
-          dat_in[clip(y - 1, imageHeight-1) * imageWidth + x] * kernel[0] +
-          dat_in[y * imageWidth + x]                          * kernel[1] +
-          dat_in[clip(y + 1, imageHeight-1) * imageWidth + x] * kernel[2];
+          applyKernel(dat_in[clip(y - 1, imageHeight-1) * imageWidth + x],
+                      dat_in[y * imageWidth + x],
+                      dat_in[clip(y + 1, imageHeight-1) * imageWidth + x]);
       }
     }
   }
@@ -98,9 +137,9 @@ public:
     for (int y = 0; y < imageHeight; y++) {
       for (int x = 0; x < imageWidth; x++) {
         *(dx + y * imageWidth + x) =
-          dat_in[y * imageWidth + clip(x - 1, imageWidth-1)] * kernel[0] +
-          dat_in[y * imageWidth + x]                         * kernel[1] +
-          dat_in[y * imageWidth + clip(x + 1, imageWidth-1)] * kernel[2];
+          applyKernel(dat_in[y * imageWidth + clip(x - 1, imageWidth-1)],
+                      dat_in[y * imageWidth + x],
+                      dat_in[y * imageWidth + clip(x + 1, imageWidth-1)]);
       }
     }
   }
@@ -108,28 +147,49 @@ public:
   //--------------------------------------------------------------------------
   // Function: magnitudeAngle
   //   Compute the magnitute and angle based on the horizontal and vertical
-  //   derivative results
-  void magnitudeAngle(double *dx, 
-                      double *dy, 
-                      double *magn, 
-                      double *angle) 
+  //   derivative results. Only the outputs in mask are computed, the angle
+  //   threshold is compared on the squared magnitude so an angle only run
+  //   needs no sqrt.
+  void magnitudeAngle(double *dx,
+                      double *dy,
+                      double *magn,
+                      double *angle,
+                      int     mask = edgeBoth,
+                      double  magThresh = 0)
   {
     double dx_sq;
     double dy_sq;
-    double sum;
+    double sum = 0;
+    double threshSq = magThresh * magThresh;
     for (int y = 0; y < imageHeight; y++) {
       for (int x = 0; x < imageWidth; x++) {
-        dx_sq = *(dx + y * imageWidth + x) * *(dx + y * imageWidth + x);
-        dy_sq = *(dy + y * imageWidth + x) * *(dy + y * imageWidth + x);
-        sum = dx_sq + dy_sq;
-        *(magn + y * imageWidth + x) = sqrt(sum);
-        *(angle + y * imageWidth + x) = atan2(dy[y * imageWidth + x], dx[y * imageWidth + x]);
+        if ((mask & edgeMagnitude) || (magThresh > 0)) {
+          dx_sq = *(dx + y * imageWidth + x) * *(dx + y * imageWidth + x);
+          dy_sq = *(dy + y * imageWidth + x) * *(dy + y * imageWidth + x);
+          sum = dx_sq + dy_sq;
+        }
+        if (mask & edgeMagnitude) {
+          *(magn + y * imageWidth + x) = sqrt(sum);
+        }
+        if (mask & edgeAngle) {
+          *(angle + y * imageWidth + x) = (sum < threshSq) ? 0 : atan2(dy[y * imageWidth + x], dx[y * imageWidth + x]);
+        }
       }
     }
   }
 
 private: // Helper functions
 
+  //--------------------------------------------------------------------------
+  // Function: applyKernel
+  //   Derivative of three pixels with the current kernel
+  int applyKernel(unsigned char pix2, unsigned char pix1, unsigned char pix0) {
+    if (progKernel) {
+      return pix2 * kernel[0] + pix1 * kernel[1] + pix0 * kernel[2];
+    }
+    return edgeKernel::apply(pix2, pix1, pix0);
+  }
+
   //--------------------------------------------------------------------------
   // Function: clip
   //   Perform boundary processing by "adjusting" the index value to "clip"
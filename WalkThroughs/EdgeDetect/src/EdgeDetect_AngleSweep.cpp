@@ -0,0 +1,139 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+// Host sweep of the CircularBuf angle precision. Runs the design for a set
+// of angle widths with the ac_atan2_cordic path and with the vectoring
+// CORDIC at a set of iteration counts, and reports the angle error of each
+// against EdgeDetect_Algorithm. Use it to pick the cheapest setting that
+// meets an accuracy spec.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_CircularBuf.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+const int iW = 1296;
+const int iH = 864;
+
+// Angle width and magnitude policy of one sweep point
+template <int aW, class mT> struct sweepConfig : circularBufConfig
+{
+  enum { angW = aW };
+  typedef mT magT;
+};
+
+// Run one setting and print its angle error per pixel
+template <int angW, class magT>
+static void sweep(const unsigned char *img, const double *angle_ref, const char *mode, int iterations)
+{
+  typedef EdgeDetect_CircularBuf<iW,iH,sweepConfig<angW,magT> > dutT;
+  dutT *dut = new dutT;
+  typename dutT::maxW widthIn = iW;
+  typename dutT::maxH heightIn = iH;
+  ac_channel<uint8>                  dat_in;
+  ac_channel<uint9>                  magn;
+  ac_channel<ac_fixed<angW,3> >      angle;
+
+  for (int i = 0; i < iH*iW; i++) {
+    dat_in.write(img[i]);
+  }
+  dut->run(dat_in, widthIn, heightIn, magn, angle);
+
+  double sumErr = 0;
+  double maxErr = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    magn.read();
+    double err = fabs(angle_ref[i] - angle.read().to_double());
+    sumErr += err;
+    maxErr = std::max(maxErr, err);
+  }
+  printf("%5d  %-16s %10d  %14f  %10f\n", angW, mode, iterations, sumErr/(iH*iW), maxErr);
+  delete dut;
+}
+
+// All iteration counts of the vectoring CORDIC for one angle width
+template <int angW>
+static void sweepWidth(const unsigned char *img, const double *angle_ref)
+{
+  sweep<angW,magSqrt>(img, angle_ref, "ac_atan2_cordic", angW);
+  sweep<angW,magCordic<6> >(img, angle_ref, "magCordic", 6);
+  sweep<angW,magCordic<8> >(img, angle_ref, "magCordic", 8);
+  sweep<angW,magCordic<10> >(img, angle_ref, "magCordic", 10);
+  sweep<angW,magCordic<12> >(img, angle_ref, "magCordic", 12);
+  sweep<angW,magCordic<14> >(img, angle_ref, "magCordic", 14);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned long int width = iW;
+  long int height         = iH;
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  if (argc < 2) {
+    cout << "Usage: " << argv[0] << " <inputbmp>" << endl;
+    return -1;
+  }
+
+  bmp_read(argv[1], &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+  EdgeDetect_Algorithm alg;
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+  alg.run(rarray, magn_orig, angle_orig); // just using red component (pseudo monochrome)
+
+  // ac_atan2_cordic iterations follow the angle precision, listed as the angle width
+  printf("angW   mode             iterations  norm per pixel   max error\n");
+  sweepWidth<6>(rarray, angle_orig);
+  sweepWidth<8>(rarray, angle_orig);
+  sweepWidth<10>(rarray, angle_orig);
+  sweepWidth<12>(rarray, angle_orig);
+
+  delete[] magn_orig;
+  delete[] angle_orig;
+  delete[] rarray;
+  delete[] garray;
+  delete[] barray;
+
+  return 0;
+}
@@ -68,7 +68,9 @@ public:
   //--------------------------------------------------------------------------
   // Function: run
   //   Top interface for data in/out of class. Combines vertical and 
-  //   horizontal derivative and magnitude/angle computation.
+  //   horizontal derivative and magnitude/angle computation. outputs
+  //   selects magnitude, angle or both, an output not built may be NULL.
+  template <int outputs = edgeBoth>
   void run(pixelType  *dat_in,  // 8-bit unsigned for pixel data
            magType    *magn,    // 9-bit unsigned for magnitude output
            angType    *angle)   // 3-integer/5-fractional bits for quantized output
@@ -79,7 +81,7 @@ public:
 
     verticalDerivative(dat_in, dy);
     horizontalDerivative(dat_in, dx);
-    magnitudeAngle(dx, dy, magn, angle);
+    magnitudeAngle<outputs>(dx, dy, magn, angle);
 
     free(dy);
     free(dx);
@@ -94,9 +96,9 @@ public:
     for (int y = 0; y < imageHeight; y++) {
       for (int x = 0; x < imageWidth; x++) {
         *(dy + y * imageWidth + x) =
-          dat_in[clip(y - 1, imageHeight-1) * imageWidth + x] * kernel[0] +
-          dat_in[y * imageWidth + x]                          * kernel[1] +
-          dat_in[clip(y + 1, imageHeight-1) * imageWidth + x] * kernel[2];
+          edgeKernel::apply(dat_in[clip(y - 1, imageHeight-1) * imageWidth + x],
+                            dat_in[y * imageWidth + x],
+                            dat_in[clip(y + 1, imageHeight-1) * imageWidth + x]);
       }
     }
   }
@@ -110,9 +112,9 @@ public:
     for (int y = 0; y < imageHeight; y++) {
       for (int x = 0; x < imageWidth; x++) {
         *(dx + y * imageWidth + x) =
-          dat_in[y * imageWidth + clip(x - 1, imageWidth-1)] * kernel[0] +
-          dat_in[y * imageWidth + x]                         * kernel[1] +
-          dat_in[y * imageWidth + clip(x + 1, imageWidth-1)] * kernel[2];
+          edgeKernel::apply(dat_in[y * imageWidth + clip(x - 1, imageWidth-1)],
+                            dat_in[y * imageWidth + x],
+                            dat_in[y * imageWidth + clip(x + 1, imageWidth-1)]);
       }
     }
   }
@@ -121,6 +123,7 @@ public:
   // Function: magnitudeAngle
   //   Compute the magnitute and angle based on the horizontal and vertical
   //   derivative results
+  template <int outputs = edgeBoth>
   void magnitudeAngle(gradType *dx, 
                       gradType *dy, 
                       magType *magn, 
@@ -131,11 +134,15 @@ public:
     sumType sum;
     for (int y = 0; y < imageHeight; y++) {
       for (int x = 0; x < imageWidth; x++) {
-        dx_sq = *(dx + y * imageWidth + x) * *(dx + y * imageWidth + x);
-        dy_sq = *(dy + y * imageWidth + x) * *(dy + y * imageWidth + x);
-        sum = dx_sq + dy_sq;
-        *(magn + y * imageWidth + x) = sqrt(sum.to_double()); // Convert ac_fixed to double to call math.h sqrt()
-        *(angle + y * imageWidth + x) = atan2(dy[y * imageWidth + x].to_int(), dx[y * imageWidth + x].to_int());
+        if (outputs & edgeMagnitude) {
+          dx_sq = *(dx + y * imageWidth + x) * *(dx + y * imageWidth + x);
+          dy_sq = *(dy + y * imageWidth + x) * *(dy + y * imageWidth + x);
+          sum = dx_sq + dy_sq;
+          *(magn + y * imageWidth + x) = sqrt(sum.to_double()); // Convert ac_fixed to double to call math.h sqrt()
+        }
+        if (outputs & edgeAngle) {
+          *(angle + y * imageWidth + x) = atan2(dy[y * imageWidth + x].to_int(), dx[y * imageWidth + x].to_int());
+        }
       }
     }
   }
@@ -125,6 +125,44 @@ CCS_MAIN(int argc, char *argv[])
   printf("Magnitude: Manhattan norm per pixel %f\n",sumErr/(iH*iW));
   printf("Angle: Manhattan norm per pixel %f\n",sumAngErr/(iH*iW));
 
+  // Magnitude only and angle only builds of both host models
+  double *magn_alg = new double[iH*iW];
+  double *angle_alg = new double[iH*iW];
+  uint9 *magn_ba = new uint9[iH*iW];
+  ac_fixed<8,3> *angle_ba = new ac_fixed<8,3>[iH*iW];
+  inst0.run<edgeMagnitude>(dat_in_orig,magn_alg,NULL);
+  inst0.run<edgeAngle>(dat_in_orig,NULL,angle_alg);
+  inst1.run<edgeMagnitude>(dat_in,magn_ba,NULL);
+  inst1.run<edgeAngle>(dat_in,NULL,angle_ba);
+  int algErr = 0;
+  int baErr = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    algErr += (magn_alg[i] != magn_orig[i]) || (angle_alg[i] != angle_orig[i]);
+    baErr += (magn_ba[i] != magn[i]) || (angle_ba[i] != angle[i]);
+  }
+  printf("Algorithm single output build mismatches: %d\n", algErr);
+  printf("Bit-accurate single output build mismatches: %d\n", baErr);
+
+  // Run time output mask with the angle gated by a magnitude threshold
+  const double magThresh = 64;
+  int gateErr = 0;
+  int angles = 0;
+  inst0.run(dat_in_orig,magn_alg,angle_alg,edgeBoth,magThresh);
+  for (int i = 0; i < iH*iW; i++) {
+    bool above = magn_orig[i] >= magThresh;
+    gateErr += (magn_alg[i] != magn_orig[i]) || (angle_alg[i] != (above ? angle_orig[i] : 0));
+    angles += above;
+  }
+  inst0.run(dat_in_orig,NULL,angle_alg,edgeAngle,magThresh);
+  for (int i = 0; i < iH*iW; i++) {
+    gateErr += (angle_alg[i] != ((magn_orig[i] >= magThresh) ? angle_orig[i] : 0));
+  }
+  printf("Algorithm thresholded angle mismatches: %d, atan2 for %d of %d pixels\n", gateErr, angles, iH*iW);
+  delete[] magn_alg;
+  delete[] angle_alg;
+  delete[] magn_ba;
+  delete[] angle_ba;
+
   cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
   bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
 
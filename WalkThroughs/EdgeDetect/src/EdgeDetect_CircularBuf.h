@@ -46,10 +46,20 @@
 //    Rev 6 - Recode to use single-port memories
 //    Rev 7 - Recode to make the design programmable for image size
 //    Rev 8 - Recode to use single-port memories in circular fashion
+//            Optional small gradient fast path in magnitudeAngle
+//            Optional single dual-line memory for the vertical window
+//            Derivative kernel as a template parameter, bit growth derived
+//            from the coefficients
+//            Optional 2x/4x decimated output fused into magnitudeAngle
+//            Magnitude policy, exact sqrt or a cheap norm
+//            Optional direction bin angle without the CORDIC
+//            Optional magnitude and angle from one vectoring CORDIC
+//            Configurable angle width
+//            Pixel bit depth as a template parameter, all types derived
+//            Optional magnitude only or angle only build
 
 #include <ac_fixed.h>
 //This is Catapult's math library implementation, see docs for details
-#include <ac_math/ac_sqrt_pwl.h>
 #include <ac_math/ac_atan2_cordic.h>
 
 // Class for fifo-style hierarchical interconnect objects
@@ -57,19 +67,97 @@
 
 // Include constant kernel definition
 #include "edge_defs.h"
+// Include magnitude policies
+#include "edge_magnitude.h"
 #include <mc_scverify.h>
 
-template <int imageWidth, int imageHeight>
+//----------------------------------------------------------------------------
+// Struct: circularBufConfig
+//   Build options of EdgeDetect_CircularBuf, the defaults build the plain
+//   circular buffer design. A build derives from it and overrides only the
+//   options it changes, e.g.
+//     struct gatedConfig : circularBufConfig { enum { gateGrad = 4 }; };
+//
+// gateGrad     - gradients with |dx| and |dy| below this bound reuse a cached
+//                magnitude/angle and hold the sqrt/CORDIC operands (0 disables)
+// dualLineBuf  - store the pixels of both lines for the same two columns in
+//                one 32-bit word of a single line buffer instead of using two
+//                rotating 16-bit line buffers
+// kernelT      - constant derivative kernel, see derivKernel in edge_defs.h
+// decimate     - 1 for full resolution, 2 or 4 to output one pixel per
+//                decimate x decimate block. sqrt/CORDIC only run for the
+//                output pixels
+// maxPool      - output the block pixel with the largest magnitude instead of
+//                the top-left one
+// magT         - magnitude policy, magSqrt, magL1, magLinf,
+//                magAlphaMaxBetaMin or magCordic, see edge_magnitude.h.
+//                magCordic also produces the angle, its iterations are
+//                set by its template argument
+// angleBins    - 0 for the CORDIC angle. 4 or 8 to output the center angle of
+//                the gradient direction bin instead, found with sign and
+//                tan(22.5 deg) comparisons on dx and dy. 8 bins are the
+//                compass directions, 4 bins fold opposite directions
+//                (0, pi/4, pi/2, 3pi/4)
+// angW         - angle width, 3 integer bits and angW-3 fractional bits.
+//                The ac_atan2_cordic iterations follow the angle precision
+// pixelBits    - input pixel width, the derivative, magnitude and line
+//                buffer word widths are derived from it
+// outputs      - edgeMagnitude, edgeAngle or edgeBoth. The channel of an
+//                output not built is never written and its arithmetic is
+//                removed
+struct circularBufConfig
+{
+  enum {
+    gateGrad     = 0,
+    dualLineBuf  = 0,
+    decimate     = 1,
+    maxPool      = 0,
+    angleBins    = 0,
+    angW         = 8,
+    pixelBits    = 8,
+    outputs      = edgeBoth
+  };
+  typedef edgeKernel kernelT;
+  typedef magSqrt    magT;
+};
+
+template <int imageWidth, int imageHeight, class cfg = circularBufConfig>
 class EdgeDetect_CircularBuf
 {
+protected:
+  // Build options, see circularBufConfig
+  static const int gateGrad     = cfg::gateGrad;
+  static const int dualLineBuf  = cfg::dualLineBuf;
+  static const int decimate     = cfg::decimate;
+  static const int maxPool      = cfg::maxPool;
+  static const int angleBins    = cfg::angleBins;
+  static const int angW         = cfg::angW;
+  static const int pixelBits    = cfg::pixelBits;
+  static const int outputs      = cfg::outputs;
+  typedef typename cfg::kernelT kernelT;
+  typedef typename cfg::magT    magT;
+  typedef typename kernelT::coefs kernelCoefs; // run time kernel coefficients, empty for a constant kernel
+
+  static_assert((decimate == 1) || (decimate == 2) || (decimate == 4), "decimate must be 1, 2 or 4");
+  static_assert((angleBins == 0) || (angleBins == 4) || (angleBins == 8), "angleBins must be 0, 4 or 8");
+  static_assert(!magT::hasAngle || (angleBins == 0), "direction bins need a magnitude only policy");
+  static_assert((angW >= 5) && (angW <= 16), "angW must be 5 to 16");
+  static_assert((pixelBits >= 8) && (pixelBits <= 16), "pixelBits must be 8 to 16");
+  static_assert((outputs >= edgeMagnitude) && (outputs <= edgeBoth), "outputs must be edgeMagnitude, edgeAngle or edgeBoth");
+
   // Define some bit-accurate types to use in this model
-  typedef uint8                  pixelType;    // input pixel is 0-255
-  typedef uint16                 pixelType2x;  // two pixels packed
-  typedef int9                   gradType;     // Derivative is max range -255 to 255
-  typedef uint18                 sqType;       // Result of 9-bit x 9-bit
-  typedef ac_fixed<19,19,false>  sumType;      // Result of 18-bit + 18-bit fixed pt integer for squareroot
-  typedef uint9                  magType;      // 9-bit unsigned magnitute result
-  typedef ac_fixed<8,3,true>     angType;      // 3 integer bit, 5 fractional bits for quantized angle -pi to pi
+  typedef ac_int<pixelBits,false>   pixelType;   // input pixel is 0 to 2^pixelBits-1
+  typedef ac_int<2*pixelBits,false> pixelType2x; // two pixels packed
+  typedef ac_int<4*pixelBits,false> pixelType4x; // two pixels of two lines packed
+  enum {
+    gradW = kernelT::gradBits(pixelBits),      // -255 to 255 for 8-bit pixels and the default kernel
+    magW  = kernelT::magBits(pixelBits)        // 0 to 360 for 8-bit pixels and the default kernel
+  };
+  typedef ac_int<gradW,true>     gradType;     // Derivative range derived from the kernel coefficients
+  typedef ac_int<2*gradW,false>  sqType;       // Result of gradType x gradType
+  typedef ac_fixed<2*gradW+1,2*gradW+1,false> sumType; // Result of sqType + sqType fixed pt integer for squareroot
+  typedef ac_int<magW,false>     magType;      // unsigned magnitute result
+  typedef ac_fixed<angW,3,true>  angType;      // 3 integer bit, angW-3 fractional bits for quantized angle -pi to pi
 
   // Static interconnect channels (FIFOs) between blocks
   ac_channel<gradType>       dy;
@@ -77,11 +165,41 @@ class EdgeDetect_CircularBuf
   ac_channel<pixelType>      dat; // channel for passing input pixels to horizontalDerivative
   bool                       pp;  // flag for rotating the buffers
 
+  // Small gradient result cache, filled by the sqrt/CORDIC on first use.
+  // Cleared by magnitudeAngle at the start of every frame, a register bank
+  enum { gateSize = (gateGrad > 0) ? (2*gateGrad-1)*(2*gateGrad-1) : 1 };
+  magType                    gateMag[gateSize];
+  angType                    gateAng[gateSize];
+  bool                       gateValid[gateSize];
+
+  // Line buffer geometry
+  enum {
+    lineWords = dualLineBuf ? 1 : imageWidth/2,
+    dualWords = dualLineBuf ? imageWidth/2 : 1
+  };
+
+  // Max pooling partial results, one per output column
+  enum { poolWords = maxPool ? (imageWidth+decimate-1)/decimate : 1 };
+
 public:
+#ifndef __SYNTHESIS__
+  // Host side line buffer access counts
+  unsigned long lbReads;       // line buffer word reads
+  unsigned long lbWrites;      // line buffer word writes
+#endif
+
   //Compute number of bits for max image size count, used internally and in testbench
   typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
   typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
-  EdgeDetect_CircularBuf():pp(false) {}
+  // Output types, used in testbench and by the designs chained after it
+  typedef magType magOutType;
+  typedef angType angOutType;
+  EdgeDetect_CircularBuf():pp(false) {
+#ifndef __SYNTHESIS__
+    lbReads = 0;
+    lbWrites = 0;
+#endif
+  }
 
   //--------------------------------------------------------------------------
   // Function: run
@@ -99,7 +217,7 @@ public:
     magnitudeAngle(dx, dy, widthIn, heightIn, magn, angle);
   }
 
-private:
+protected:
   //--------------------------------------------------------------------------
   // Function: verticalDerivative
   //   Compute the vertical derivative on the input data
@@ -108,13 +226,17 @@ private:
                           maxW                  &widthIn,
                           maxH                  &heightIn,
                           ac_channel<pixelType> &dat_out,
-                          ac_channel<gradType>  &dy) 
+                          ac_channel<gradType>  &dy,
+                          const kernelCoefs     &kernelIn = kernelCoefs()) 
   {
     // Line buffers store pixel line history - Mapped to RAM
-    pixelType2x line_buf0[imageWidth/2];
-    pixelType2x line_buf1[imageWidth/2];
+    pixelType2x line_buf0[lineWords];
+    pixelType2x line_buf1[lineWords];
     pixelType2x rdbuf0_pix, rdbuf1_pix;
     pixelType2x wrbuf0_pix, wrbuf1_pix;
+    // Dual-line buffer, upper line in the upper half - Mapped to RAM
+    pixelType4x line_buf[dualWords];
+    pixelType4x rdbuf_pix, wrbuf_pix;
     pixelType pix0, pix1, pix2;
     gradType pix;
 
@@ -125,27 +247,61 @@ private:
         if ((y < imageHeight) & (x < imageWidth)) {
           pix0 = dat_in.read(); // Read streaming interface
         }
-        // Write data cache, write lower 8 on even iterations of COL loop, upper 8 on odd
-        if ( (x&1) == 0 ) {
-          wrbuf0_pix.set_slc(0,pix0);
+        if (dualLineBuf) {
+          // Write data cache, write lower pixel on even iterations of COL loop, upper pixel on odd
+          if ( (x&1) == 0 ) {
+            wrbuf0_pix.set_slc(0,pix0);
+          } else {
+            wrbuf0_pix.set_slc(pixelBits,pix0);
+          }
+          // Read both lines in one access on even iterations of COL loop
+          if ( (x&1) == 0 ) {
+            rdbuf_pix = line_buf[x/2];
+            rdbuf1_pix = rdbuf_pix.template slc<2*pixelBits>(2*pixelBits);
+            rdbuf0_pix = rdbuf_pix.template slc<2*pixelBits>(0);
+#ifndef __SYNTHESIS__
+            lbReads++;
+#endif
+          } else { // Write both lines in one access on odd iterations of COL loop
+            wrbuf_pix.set_slc(2*pixelBits,rdbuf0_pix); // lower line moves up
+            wrbuf_pix.set_slc(0,wrbuf0_pix);  // store current line
+            line_buf[x/2] = wrbuf_pix;
+#ifndef __SYNTHESIS__
+            lbWrites++;
+#endif
+          }
+          // Get pixel data from read buffer caches, lower pixel on even iterations of COL loop
+          pix2 = ((x&1)==0) ? rdbuf1_pix.template slc<pixelBits>(0) : rdbuf1_pix.template slc<pixelBits>(pixelBits);
+          pix1 = ((x&1)==0) ? rdbuf0_pix.template slc<pixelBits>(0) : rdbuf0_pix.template slc<pixelBits>(pixelBits);
         } else {
-          wrbuf0_pix.set_slc(8,pix0);
-        }
-        // Read line buffers into read buffer caches on even iterations of COL loop
-        if ( (x&1) == 0 ) {
-          // pp controls which buffer is read as upper, which as lower
-          rdbuf1_pix = pp ? line_buf1[x/2] : line_buf0[x/2];
-          rdbuf0_pix = pp ? line_buf0[x/2] : line_buf1[x/2];
-        } else { // Write line buffer caches on odd iterations of COL loop
-          // Only one buffer is ever written based on pp
-          if (pp)
-            line_buf1[x/2] = wrbuf0_pix; // store current line
-          else
-            line_buf0[x/2] = wrbuf0_pix; // store current line
+          // Write data cache, write lower pixel on even iterations of COL loop, upper pixel on odd
+          if ( (x&1) == 0 ) {
+            wrbuf0_pix.set_slc(0,pix0);
+          } else {
+            wrbuf0_pix.set_slc(pixelBits,pix0);
+          }
+          // Read line buffers into read buffer caches on even iterations of COL loop
+          if ( (x&1) == 0 ) {
+            // pp controls which buffer is read as upper, which as lower
+            rdbuf1_pix = pp ? line_buf1[x/2] : line_buf0[x/2];
+            rdbuf0_pix = pp ? line_buf0[x/2] : line_buf1[x/2];
+#ifndef __SYNTHESIS__
+            lbReads += 2;
+#endif
+          } else { // Write line buffer caches on odd iterations of COL loop
+            // Only one buffer is ever written based on pp
+            if (pp)
+              line_buf1[x/2] = wrbuf0_pix; // store current line
+            else
+              line_buf0[x/2] = wrbuf0_pix; // store current line
+#ifndef __SYNTHESIS__
+            lbWrites++;
+#endif
+          }
+          // Get pixel data from read buffer caches, lower pixel on even iterations of COL loop
+          pix2 = ((x&1)==0) ? rdbuf1_pix.template slc<pixelBits>(0) : rdbuf1_pix.template slc<pixelBits>(pixelBits);
+          pix1 = ((x&1)==0) ? rdbuf0_pix.template slc<pixelBits>(0) : rdbuf0_pix.template slc<pixelBits>(pixelBits);
         }
-        // Get 8-bit data from read buffer caches, lower 8 on even iterations of COL loop
-        pix2 = ((x&1)==0) ? rdbuf1_pix.slc<8>(0) : rdbuf1_pix.slc<8>(8);
-        pix1 = ((x&1)==0) ? rdbuf0_pix.slc<8>(0) : rdbuf0_pix.slc<8>(8);
 
         // Boundary condition processing
         if (y == 1) {
@@ -156,7 +312,7 @@ private:
         }
 
         // Calculate derivative
-        pix = pix2*kernel[0] + pix1*kernel[1] + pix0*kernel[2];
+        pix = kernelT::apply(kernelIn, pix2, pix1, pix0);
 
         if (y != 0) { // Write streaming interfaces
           dat_out.write(pix1); // Pass thru original data
@@ -182,7 +338,8 @@ private:
   void horizontalDerivative(ac_channel<pixelType> &dat_in,
                             maxW                  &widthIn,
                             maxH                  &heightIn,
-                            ac_channel<gradType>  &dx) 
+                            ac_channel<gradType>  &dx,
+                            const kernelCoefs     &kernelIn = kernelCoefs()) 
   {
     // pixel buffers store pixel history
     pixelType pix_buf0;
@@ -211,7 +368,7 @@ private:
         pix_buf1 = pix_buf0;
         pix_buf0 = pix0;
         // Calculate derivative
-        pix = pix2*kernel[0] + pix1*kernel[1] + pix0*kernel[2];
+        pix = kernelT::apply(kernelIn, pix2, pix1, pix0);
 
         if (x != 0) { // Write streaming interface
           dx.write(pix); // derivative out
@@ -226,10 +383,41 @@ private:
     }
   }
 
+  //--------------------------------------------------------------------------
+  // Function: directionAngle
+  //   Center angle of the direction bin of (dx,dy). A gradient is horizontal
+  //   when |dy| < tan(22.5 deg)*|dx|, vertical when |dx| < tan(22.5 deg)*|dy|
+  //   and diagonal otherwise, the signs pick the quadrant.
+  angType directionAngle(gradType dx, gradType dy)
+  {
+    // Center angles of directions -3 to 4, multiples of pi/4
+    static const angType dirAngle[8] = { -2.35619449, -1.57079633, -0.78539816, 0.0,
+                                          0.78539816,  1.57079633,  2.35619449, 3.14159265 };
+    ac_int<gradW,false> ax = edgeAbs(dx);
+    ac_int<gradW,false> ay = edgeAbs(dy);
+    ac_int<4,true> dir; // compass direction, multiples of pi/4 from -3 to 4
+    // 53/128 = 0.414 approximates tan(22.5 deg)
+    if ((ay * 128) <= (ax * 53)) {
+      dir = (dx < 0) ? 4 : 0;
+    } else if ((ax * 128) < (ay * 53)) {
+      dir = (dy < 0) ? -2 : 2;
+    } else if (dx > 0) {
+      dir = (dy < 0) ? -1 : 1;
+    } else {
+      dir = (dy < 0) ? -3 : 3;
+    }
+    if ((angleBins == 4) & ((dir < 0) | (dir == 4))) {
+      dir = (dir < 0) ? dir + 4 : 0; // fold opposite directions onto 0 to 3pi/4
+    }
+    return dirAngle[dir + 3];
+  }
+
   //--------------------------------------------------------------------------
   // Function: magnitudeAngle
   //   Compute the magnitute and angle based on the horizontal and vertical
-  //   derivative results
+  //   derivative results. Decimated output keeps one pixel per block, the
+  //   top-left one or, with maxPool, the one with the largest dx^2+dy^2
+  //   (sqrt is monotonic so that is the largest magnitude).
 #pragma hls_design
   void magnitudeAngle(ac_channel<gradType> &dx_in,
                       ac_channel<gradType> &dy_in,
@@ -239,24 +427,104 @@ private:
                       ac_channel<angType>  &angle) 
   {
     gradType dx, dy;
-    sqType dx_sq;
-    sqType dy_sq;
-    sumType sum; // fixed point integer for sqrt
-    angType at;
-    ac_fixed<16,9,false> sq_rt; // square-root return type
+    gradType dx_op = 0, dy_op = 0; // sqrt/CORDIC operands, held while gated
+    sumType sum; // squared magnitude for max pooling
+    magType mag, mag_op = 0;
+    angType at = 0;
+    ac_int<ac::nbits<gateSize>::val,false> gateIdx = 0;
+    ac_int<ac::nbits<gateSize>::val,false> gateClr = 0; // cache entries cleared this frame
+    bool clearing;
+    bool small;
+    bool gated;
+    bool keep; // pixel is output
+    // Max pooling, best pixel of the current line segment and of the block
+    // lines above it - Mapped to RAM
+    sumType pool_sum[poolWords];
+    gradType pool_dx[poolWords], pool_dy[poolWords];
+    sumType cur_sum = 0, blk_sum = 0;
+    gradType cur_dx = 0, cur_dy = 0;
 
     MROW: for (maxH y = 0; ; y++) {
       MCOL: for (maxW x = 0; ; x++) {
         dx = dx_in.read();
         dy = dy_in.read();
-        dx_sq = dx * dx;
-        dy_sq = dy * dy;
-        sum = dx_sq + dy_sq;
-        // Catapult's math library piecewise linear implementation of sqrt and atan2
-        ac_math::ac_sqrt_pwl(sum,sq_rt);
-        magn.write(sq_rt.to_uint());
-        ac_math::ac_atan2_cordic((ac_fixed<9,9>)dy, (ac_fixed<9,9>) dx, at);
-        angle.write(at);
+        if (maxPool) {
+          sum = dx * dx + dy * dy;
+          if (((x & (decimate-1)) == 0) || (sum > cur_sum)) {
+            cur_sum = sum;
+            cur_dx = dx;
+            cur_dy = dy;
+          }
+          // End of the line segment, merge with the lines above
+          keep = false;
+          if (((x & (decimate-1)) == decimate-1) || (x == maxW(widthIn-1))) {
+            blk_sum = pool_sum[x/decimate];
+            if (((y & (decimate-1)) != 0) && (blk_sum >= cur_sum)) {
+              cur_sum = blk_sum;
+              cur_dx = pool_dx[x/decimate];
+              cur_dy = pool_dy[x/decimate];
+            }
+            pool_sum[x/decimate] = cur_sum;
+            pool_dx[x/decimate] = cur_dx;
+            pool_dy[x/decimate] = cur_dy;
+            keep = ((y & (decimate-1)) == decimate-1) || (y == maxH(heightIn-1));
+          }
+          dx = cur_dx;
+          dy = cur_dy;
+        } else {
+          keep = ((x & (decimate-1)) == 0) & ((y & (decimate-1)) == 0);
+        }
+        // Clear one cache entry per pixel at the start of the frame, so
+        // nothing depends on the power-up contents. The cache is neither
+        // read nor filled until every entry has been cleared
+        clearing = (gateGrad > 0) & (gateClr != gateSize);
+        if (clearing) {
+          gateValid[gateClr] = false;
+          gateClr++;
+        }
+        // Small gradient fast path, gated pixels take the cached result
+        small = !clearing & (gateGrad > 0) & (dx > -gateGrad) & (dx < gateGrad) & (dy > -gateGrad) & (dy < gateGrad);
+        if (small) {
+          gateIdx = (dy + (gateGrad-1))*(2*gateGrad-1) + (dx + (gateGrad-1));
+        }
+        gated = small & gateValid[gateIdx];
+        if (keep & !gated) { // operand isolation, nothing toggles while gated or dropped
+          dx_op = dx;
+          dy_op = dy;
+          if (magT::hasAngle) {
+            // One vectoring CORDIC for both magnitude and angle
+            magT::template vector<gradW,magW>(dx_op, dy_op, mag_op, at);
+          } else {
+            if (outputs & edgeMagnitude) {
+              mag_op = magT::template apply<gradW,magW>(dx_op, dy_op);
+            }
+            if ((outputs & edgeAngle) && (angleBins == 0)) {
+              // Catapult's math library implementation of atan2
+              ac_math::ac_atan2_cordic((ac_fixed<gradW,gradW>)dy_op, (ac_fixed<gradW,gradW>)dx_op, at);
+            } else if (outputs & edgeAngle) {
+              at = directionAngle(dx_op, dy_op);
+            }
+          }
+        }
+        if (gated) {
+          mag = gateMag[gateIdx];
+          at = gateAng[gateIdx];
+        } else {
+          mag = mag_op;
+          if (small & keep) { // first output occurrence fills the cache
+            gateMag[gateIdx] = mag;
+            gateAng[gateIdx] = at;
+            gateValid[gateIdx] = true;
+          }
+        }
+        if (keep) { // Write streaming interfaces of the outputs built
+          if (outputs & edgeMagnitude) {
+            magn.write(mag);
+          }
+          if (outputs & edgeAngle) {
+            angle.write(at);
+          }
+        }
         // programmable width exit condition
         if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
           break;
@@ -24,7 +24,7 @@ options set Flows/LowPower/SWITCHING_ACTIVITY_TYPE saif
 solution options set /ComponentLibs/SearchPath $sfd -append
 
 go analyze
-directive set -DESIGN_HIERARCHY {{EdgeDetect_CircularBuf<1296, 864>} {EdgeDetect_CircularBuf<1296, 864>::verticalDerivative} {EdgeDetect_CircularBuf<1296, 864>::horizontalDerivative} {EdgeDetect_CircularBuf<1296, 864>::magnitudeAngle}}
+directive set -DESIGN_HIERARCHY {{EdgeDetect_CircularBuf<1296, 864, circularBufConfig>} {EdgeDetect_CircularBuf<1296, 864, circularBufConfig>::verticalDerivative} {EdgeDetect_CircularBuf<1296, 864, circularBufConfig>::horizontalDerivative} {EdgeDetect_CircularBuf<1296, 864, circularBufConfig>::magnitudeAngle}}
 go compile
 solution library add nangate-45nm_beh -file {$MGC_HOME/pkgs/siflibs/nangate/nangate-45nm_beh.lib} -- -rtlsyntool OasysRTL
 solution library add ram_1k_16_sp 
@@ -32,13 +32,13 @@ solution library add ram_1k_16_sp
 go libraries
 directive set -CLOCKS {clk {-CLOCK_PERIOD 3.33 -CLOCK_EDGE rising -CLOCK_UNCERTAINTY 0.0 -CLOCK_HIGH_TIME 1.665 -RESET_SYNC_NAME rst -RESET_ASYNC_NAME arst_n -RESET_KIND sync -RESET_SYNC_ACTIVE high -RESET_ASYNC_ACTIVE low -ENABLE_ACTIVE high}}
 go assembly
-directive set /EdgeDetect_CircularBuf<1296,864>/verticalDerivative/core/line_buf0:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
-directive set /EdgeDetect_CircularBuf<1296,864>/verticalDerivative/core/line_buf1:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
-directive set /EdgeDetect_CircularBuf<1296,864>/verticalDerivative/core/VROW -PIPELINE_INIT_INTERVAL 1
-directive set /EdgeDetect_CircularBuf<1296,864>/horizontalDerivative/core/HROW -PIPELINE_INIT_INTERVAL 1
-directive set /EdgeDetect_CircularBuf<1296,864>/magnitudeAngle/core/MROW -PIPELINE_INIT_INTERVAL 1
-directive set /EdgeDetect_CircularBuf<1296,864>/magnitudeAngle/core/ac_math::ac_atan2_cordic<9,9,AC_TRN,AC_WRAP,9,9,AC_TRN,AC_WRAP,8,3,AC_TRN,AC_WRAP>:for -UNROLL yes
-directive set /EdgeDetect_CircularBuf<1296,864>/widthIn:rsc -MAP_TO_MODULE {[DirectInput]}
-directive set /EdgeDetect_CircularBuf<1296,864>/heightIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/verticalDerivative/core/line_buf0:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/verticalDerivative/core/line_buf1:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/verticalDerivative/core/VROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/horizontalDerivative/core/HROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/magnitudeAngle/core/MROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/magnitudeAngle/core/ac_math::ac_atan2_cordic<9,9,AC_TRN,AC_WRAP,9,9,AC_TRN,AC_WRAP,8,3,AC_TRN,AC_WRAP>:for -UNROLL yes
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/widthIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/heightIn:rsc -MAP_TO_MODULE {[DirectInput]}
 go architect
 go extract
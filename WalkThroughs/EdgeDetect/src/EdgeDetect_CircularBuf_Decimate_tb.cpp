@@ -0,0 +1,154 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+// Decimated output of EdgeDetect_CircularBuf. The 2x build must output the
+// top-left pixel of every block of the full resolution build, the 4x max
+// pooled build the largest magnitude of every block with the angle of a
+// pixel having it. Exits nonzero on any mismatch.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_CircularBuf.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <mc_scverify.h>
+
+const int iW = 1296;
+const int iH = 864;
+
+// Build options of the variants checked below
+struct dec2Config  : circularBufConfig { enum { decimate = 2 }; };
+struct pool4Config : circularBufConfig { enum { decimate = 4, maxPool = 1 }; };
+
+// Run one build over the image, the outputs stay in the channels
+template <class cfgT>
+static void runEdge(const unsigned char *img, ac_channel<uint9> &magn, ac_channel<ac_fixed<8,3> > &angle)
+{
+  typedef EdgeDetect_CircularBuf<iW,iH,cfgT> dutT;
+  dutT *dut = new dutT;
+  typename dutT::maxW widthIn = iW;
+  typename dutT::maxH heightIn = iH;
+  ac_channel<uint8> dat_in;
+
+  for (int i = 0; i < iH*iW; i++) {
+    dat_in.write(img[i]);
+  }
+  dut->run(dat_in, widthIn, heightIn, magn, angle);
+  delete dut;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  unsigned long int width = iW;
+  long int height         = iH;
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  if (argc < 2) {
+    cout << "Usage: " << argv[0] << " <inputbmp>" << endl;
+    CCS_RETURN(-1);
+  }
+  bmp_read(argv[1], &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+  ac_channel<uint9>            magn, magn_dec2, magn_dec4;
+  ac_channel<ac_fixed<8,3> >   angle, angle_dec2, angle_dec4;
+  int *magn_hw = new int[iH*iW];
+  ac_fixed<8,3> *angle_hw = new ac_fixed<8,3>[iH*iW];
+
+  runEdge<circularBufConfig>(rarray, magn, angle);
+  runEdge<dec2Config>(rarray, magn_dec2, angle_dec2);
+  runEdge<pool4Config>(rarray, magn_dec4, angle_dec4);
+  for (int i = 0; i < iH*iW; i++) {
+    magn_hw[i] = magn.read();
+    angle_hw[i] = angle.read();
+  }
+
+  // Decimated outputs against the full resolution output, subsampled and
+  // max pooled. The pooled angle must belong to a pixel of maximum magnitude
+  int dec2Err = 0;
+  int dec4Err = 0;
+  int dec2Out = 0;
+  int dec4Out = 0;
+  for (int y = 0; y < iH; y += 2) {
+    for (int x = 0; x < iW; x += 2) {
+      if ((magn_dec2.read() != magn_hw[y*iW+x]) || (angle_dec2.read() != angle_hw[y*iW+x])) {
+        dec2Err++;
+      }
+      dec2Out++;
+    }
+  }
+  for (int y = 0; y < iH; y += 4) {
+    for (int x = 0; x < iW; x += 4) {
+      int m = magn_dec4.read();
+      ac_fixed<8,3> a = angle_dec4.read();
+      int best = 0;
+      bool angMatch = false;
+      for (int i = y; i < std::min(y+4, iH); i++) {
+        for (int j = x; j < x+4; j++) {
+          best = std::max(best, magn_hw[i*iW+j]);
+        }
+      }
+      for (int i = y; i < std::min(y+4, iH); i++) {
+        for (int j = x; j < x+4; j++) {
+          angMatch |= (magn_hw[i*iW+j] == best) && (angle_hw[i*iW+j] == a);
+        }
+      }
+      if ((m != best) || !angMatch) {
+        dec4Err++;
+      }
+      dec4Out++;
+    }
+  }
+  dec2Err += magn_dec2.size() + angle_dec2.size(); // outputs beyond the decimated frame
+  dec4Err += magn_dec4.size() + angle_dec4.size();
+  printf("2x decimated output mismatches: %d, sqrt/CORDIC for %d of %d pixels\n", dec2Err, dec2Out, iW*iH);
+  printf("4x max pooled output mismatches: %d, sqrt/CORDIC for %d of %d pixels\n", dec4Err, dec4Out, iW*iH);
+
+  delete[] magn_hw;
+  delete[] angle_hw;
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  int errors = dec2Err + dec4Err;
+  printf("%s: %d mismatches\n", errors ? "FAILED" : "PASSED", errors);
+  CCS_RETURN(errors ? 1 : 0);
+}
@@ -0,0 +1,176 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+// Line buffer options of EdgeDetect_CircularBuf: the single dual-line
+// buffer and deeper pixels. Each build must match the build with two raw
+// line buffers bit for bit. Exits nonzero on any mismatch.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_CircularBuf.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <mc_scverify.h>
+
+const int iW = 1296;
+const int iH = 864;
+
+// Build options of the variants checked below
+template <int bits, int dual> struct pixelConfig : circularBufConfig { enum { pixelBits = bits, dualLineBuf = dual }; };
+
+// Run one build over the image scaled to its pixel width
+template <class dutT, int pixelBits>
+static void runEdge(dutT *dut, const unsigned char *img, int *magn_hw, double *angle_hw)
+{
+  typedef ac_int<pixelBits,false> pixT;
+  typedef ac_int<edgeKernel::magBits(pixelBits),false> magT;
+  typename dutT::maxW widthIn = iW;
+  typename dutT::maxH heightIn = iH;
+  ac_channel<pixT>             dat_in;
+  ac_channel<magT>             magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+
+  for (int i = 0; i < iH*iW; i++) {
+    dat_in.write(pixT(img[i]) << (pixelBits-8));
+  }
+  dut->run(dat_in, widthIn, heightIn, magn, angle);
+  for (int i = 0; i < iH*iW; i++) {
+    magn_hw[i] = magn.read();
+    angle_hw[i] = angle.read().to_double();
+  }
+}
+
+// Count the pixels where two runs differ
+static int compare(const int *magn_a, const double *angle_a, const int *magn_b, const double *angle_b)
+{
+  int err = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    err += (magn_a[i] != magn_b[i]) || (angle_a[i] != angle_b[i]);
+  }
+  return err;
+}
+
+// Deeper pixels, the dual-line buffer must match two line buffers and the
+// result scaled back to 8 bits must be within one LSB of the 8-bit build
+template <int pixelBits>
+static int checkPixelBits(const unsigned char *img, const int *magn_8, const double *angle_8)
+{
+  typedef EdgeDetect_CircularBuf<iW,iH,pixelConfig<pixelBits,0> > dutT;
+  typedef EdgeDetect_CircularBuf<iW,iH,pixelConfig<pixelBits,1> > dualT;
+  dutT *dut = new dutT;
+  dualT *dual = new dualT;
+  int *magn_hw = new int[iH*iW];
+  int *magn_dual = new int[iH*iW];
+  double *angle_hw = new double[iH*iW];
+  double *angle_dual = new double[iH*iW];
+
+  runEdge<dutT,pixelBits>(dut, img, magn_hw, angle_hw);
+  runEdge<dualT,pixelBits>(dual, img, magn_dual, angle_dual);
+  int dualErr = compare(magn_hw, angle_hw, magn_dual, angle_dual);
+  int scaleErr = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    scaleErr += (fabs(magn_hw[i] / (double)(1 << (pixelBits-8)) - magn_8[i]) > 1) || (fabs(angle_hw[i] - angle_8[i]) > 1.0/32);
+  }
+  printf("%d-bit pixels: %d-bit gradient, %d-bit magnitude\n", pixelBits, edgeKernel::gradBits(pixelBits), edgeKernel::magBits(pixelBits));
+  printf("%d-bit pixels: Dual-line buffer mismatches: %d\n", pixelBits, dualErr);
+  printf("%d-bit pixels: %d pixels more than one LSB from the 8-bit build\n", pixelBits, scaleErr);
+  delete dut;
+  delete dual;
+  delete[] magn_hw;
+  delete[] magn_dual;
+  delete[] angle_hw;
+  delete[] angle_dual;
+  return dualErr + scaleErr;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  unsigned long int width = iW;
+  long int height         = iH;
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  if (argc < 2) {
+    cout << "Usage: " << argv[0] << " <inputbmp>" << endl;
+    CCS_RETURN(-1);
+  }
+  bmp_read(argv[1], &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+  EdgeDetect_CircularBuf<iW,iH>                              *inst1 = new EdgeDetect_CircularBuf<iW,iH>;
+  EdgeDetect_CircularBuf<iW,iH,pixelConfig<8,1> >            *inst3 = new EdgeDetect_CircularBuf<iW,iH,pixelConfig<8,1> >;
+  int *magn_hw = new int[iH*iW];
+  int *magn_var = new int[iH*iW];
+  double *angle_hw = new double[iH*iW];
+  double *angle_var = new double[iH*iW];
+  int errors = 0;
+
+  // Two raw line buffers, the reference
+  runEdge<EdgeDetect_CircularBuf<iW,iH>,8>(inst1, rarray, magn_hw, angle_hw);
+
+  // Single dual-line buffer
+  runEdge<EdgeDetect_CircularBuf<iW,iH,pixelConfig<8,1> >,8>(inst3, rarray, magn_var, angle_var);
+  int dualErr = compare(magn_hw, angle_hw, magn_var, angle_var);
+  printf("Dual-line buffer mismatches: %d\n", dualErr);
+  errors += dualErr;
+  // Access counts for the same frame with two line buffers and one dual-line buffer
+  printf("Line buffer accesses, two 16-bit RAMs: %lu reads, %lu writes, %f per pixel\n",
+         inst1->lbReads, inst1->lbWrites, (float)(inst1->lbReads+inst1->lbWrites)/(iW*(iH+1)));
+  printf("Line buffer accesses, one 32-bit RAM:  %lu reads, %lu writes, %f per pixel\n",
+         inst3->lbReads, inst3->lbWrites, (float)(inst3->lbReads+inst3->lbWrites)/(iW*(iH+1)));
+
+  // Deeper pixels
+  errors += checkPixelBits<10>(rarray, magn_hw, angle_hw);
+  errors += checkPixelBits<12>(rarray, magn_hw, angle_hw);
+
+  delete inst1;
+  delete inst3;
+  delete[] magn_hw;
+  delete[] magn_var;
+  delete[] angle_hw;
+  delete[] angle_var;
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  printf("%s: %d mismatches\n", errors ? "FAILED" : "PASSED", errors);
+  CCS_RETURN(errors ? 1 : 0);
+}
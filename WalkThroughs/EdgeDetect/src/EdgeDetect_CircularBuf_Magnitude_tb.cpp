@@ -0,0 +1,308 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+// Magnitude and angle options of EdgeDetect_CircularBuf: the small gradient
+// gate, the magnitude policies, the direction bins, the vectoring CORDIC and
+// the single output builds. Each build is compared against the default
+// build or against a host model of its arithmetic on the algorithm
+// derivatives. The Manhattan norm error of every magnitude mode against the
+// algorithm is reported. Exits nonzero on any mismatch.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_CircularBuf.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <new>
+#include <mc_scverify.h>
+
+const int iW = 1296;
+const int iH = 864;
+
+// Build options of the variants checked below
+struct gateConfig : circularBufConfig { enum { gateGrad = 4 }; };
+template <class mT> struct magConfig : circularBufConfig { typedef mT magT; };
+template <int bins> struct binConfig : circularBufConfig { enum { angleBins = bins }; };
+template <int outs> struct outputConfig : circularBufConfig { enum { outputs = outs }; };
+
+// Run one build over the image. An output the build does not have is
+// skipped and counted in unwritten if anything was written to it. With
+// powerUp the design is built over memory holding a nonzero pattern, as
+// registers and RAMs that are not reset come out of power up.
+template <class cfgT>
+static void runEdge(const unsigned char *img, int *magn_hw, ac_fixed<8,3> *angle_hw, int &unwritten, bool powerUp = false)
+{
+  typedef EdgeDetect_CircularBuf<iW,iH,cfgT> dutT;
+  unsigned char *mem = new unsigned char[sizeof(dutT)];
+  memset(mem, powerUp ? 0x01 : 0x00, sizeof(dutT));
+  dutT *dut = new (mem) dutT;
+  typename dutT::maxW widthIn = iW;
+  typename dutT::maxH heightIn = iH;
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+
+  for (int i = 0; i < iH*iW; i++) {
+    dat_in.write(img[i]);
+  }
+  dut->run(dat_in, widthIn, heightIn, magn, angle);
+
+  unwritten = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    if (cfgT::outputs & edgeMagnitude) {
+      magn_hw[i] = magn.read();
+    }
+    if (cfgT::outputs & edgeAngle) {
+      angle_hw[i] = angle.read();
+    }
+  }
+  unwritten = magn.size() + angle.size();
+  dut->~dutT();
+  delete[] mem;
+}
+
+// Host models of the cheap magnitude policies, 9-bit saturated
+static int magL1Ref(int dx, int dy)   { return std::min(abs(dx) + abs(dy), 511); }
+static int magLinfRef(int dx, int dy) { return std::max(abs(dx), abs(dy)); }
+static int magAmbmRef(int dx, int dy)
+{
+  int mx = std::max(abs(dx), abs(dy));
+  int mn = std::min(abs(dx), abs(dy));
+  return std::min((30*mx + 15*mn + 16) >> 5, 511);
+}
+
+// Host model of the direction bin, compass direction -3 to 4 in multiples of
+// pi/4, folded onto 0 to 3 for 4 bins
+static int dirRef(int dx, int dy, int bins)
+{
+  int ax = abs(dx);
+  int ay = abs(dy);
+  int dir;
+  if (ay * 128 <= ax * 53) {
+    dir = (dx < 0) ? 4 : 0;
+  } else if (ax * 128 < ay * 53) {
+    dir = (dy < 0) ? -2 : 2;
+  } else if (dx > 0) {
+    dir = (dy < 0) ? -1 : 1;
+  } else {
+    dir = (dy < 0) ? -3 : 3;
+  }
+  if ((bins == 4) && ((dir < 0) || (dir == 4))) {
+    dir = (dir < 0) ? dir + 4 : 0;
+  }
+  return dir;
+}
+
+// Count the pixels where a policy differs from its host model
+static int checkPolicy(const char *name, const int *magn_hw, const double *dx, const double *dy, int (*ref)(int, int))
+{
+  int err = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    err += (magn_hw[i] != ref((int)dx[i], (int)dy[i]));
+  }
+  printf("Magnitude %-18s: %d mismatches against the host model\n", name, err);
+  return err;
+}
+
+// Report the magnitude error of a policy against the algorithm
+static void checkMagnitude(const char *name, const int *magn_hw, const double *magn_ref)
+{
+  float sumErr = 0;
+  int maxErr = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    int diff = abs((int)magn_ref[i] - magn_hw[i]);
+    sumErr += diff;
+    maxErr = std::max(maxErr, diff);
+  }
+  printf("Magnitude %-18s: Manhattan norm per pixel %f, max %d against the algorithm\n", name, sumErr/(iH*iW), maxErr);
+}
+
+// Report the CORDIC magnitude error against the sqrt_pwl output and the
+// algorithm, and its angle error against the algorithm
+static void checkCordic(int iterations, const int *magn_cordic, const ac_fixed<8,3> *angle_cordic,
+                        const int *magn_hw, const double *magn_ref, const double *angle_ref)
+{
+  float sumErr = 0;
+  float sumAlgErr = 0;
+  float sumAngErr = 0;
+  int maxErr = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    int diff = abs(magn_hw[i] - magn_cordic[i]);
+    sumErr += diff;
+    maxErr = std::max(maxErr, diff);
+    sumAlgErr += abs((int)magn_ref[i] - magn_cordic[i]);
+    sumAngErr += fabs(angle_ref[i] - angle_cordic[i].to_double());
+  }
+  printf("CORDIC magnitude (%d iterations): Manhattan norm per pixel %f (max %d) against sqrt_pwl, %f against algorithm\n",
+         iterations, sumErr/(iH*iW), maxErr, sumAlgErr/(iH*iW));
+  printf("CORDIC angle (%d iterations): Manhattan norm per pixel %f\n", iterations, sumAngErr/(iH*iW));
+}
+
+// Count the pixels where a direction bin build differs from the host model,
+// and report how often the bin differs from the rounded algorithm angle
+static int checkDirection(int bins, const ac_fixed<8,3> *angle_hw, const double *dx, const double *dy, const double *angle_ref)
+{
+  int err = 0;
+  int algDiff = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    int hw = (int)floor(angle_hw[i].to_double() / (M_PI/4) + 0.5);
+    int alg = (int)floor(angle_ref[i] / (M_PI/4) + 0.5);
+    if (bins == 4) { // fold opposite directions
+      alg = (alg + 4) % 4;
+    } else {
+      alg = (alg == -4) ? 4 : alg;
+    }
+    err += (hw != dirRef((int)dx[i], (int)dy[i], bins));
+    algDiff += (hw != alg);
+  }
+  printf("%d direction bins: %d mismatches against the host model, %d pixels differ from the binned algorithm angle\n",
+         bins, err, algDiff);
+  return err;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  EdgeDetect_Algorithm inst0;
+  unsigned long int width = iW;
+  long int height         = iH;
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  if (argc < 2) {
+    cout << "Usage: " << argv[0] << " <inputbmp>" << endl;
+    CCS_RETURN(-1);
+  }
+  bmp_read(argv[1], &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+  double *dx = new double[iH*iW];
+  double *dy = new double[iH*iW];
+  double *magn_ref = new double[iH*iW];
+  double *angle_ref = new double[iH*iW];
+  int *magn_hw = new int[iH*iW];
+  int *magn_var = new int[iH*iW];
+  ac_fixed<8,3> *angle_hw = new ac_fixed<8,3>[iH*iW];
+  ac_fixed<8,3> *angle_var = new ac_fixed<8,3>[iH*iW];
+  int errors = 0;
+  int unwritten;
+
+  // Algorithm derivatives for the host models
+  inst0.run(rarray, magn_ref, angle_ref);
+  inst0.verticalDerivative(rarray, dy);
+  inst0.horizontalDerivative(rarray, dx);
+
+  // Default build, the reference for the bit-exact variants
+  runEdge<circularBufConfig>(rarray, magn_hw, angle_hw, unwritten);
+  checkMagnitude("sqrt_pwl", magn_hw, magn_ref);
+
+  // Small gradient gate, starting from a cache that holds garbage
+  int gateErr = 0;
+  runEdge<gateConfig>(rarray, magn_var, angle_var, unwritten, true);
+  for (int i = 0; i < iH*iW; i++) {
+    gateErr += (magn_var[i] != magn_hw[i]) || (angle_var[i] != angle_hw[i]);
+  }
+  printf("Gated fast path mismatches: %d\n", gateErr);
+  errors += gateErr;
+
+  // Magnitude policies
+  runEdge<magConfig<magL1> >(rarray, magn_var, angle_var, unwritten);
+  errors += checkPolicy("L1", magn_var, dx, dy, magL1Ref);
+  checkMagnitude("L1", magn_var, magn_ref);
+  runEdge<magConfig<magLinf> >(rarray, magn_var, angle_var, unwritten);
+  errors += checkPolicy("Linf", magn_var, dx, dy, magLinfRef);
+  checkMagnitude("Linf", magn_var, magn_ref);
+  runEdge<magConfig<magAlphaMaxBetaMin> >(rarray, magn_var, angle_var, unwritten);
+  errors += checkPolicy("alpha-max-beta-min", magn_var, dx, dy, magAmbmRef);
+  checkMagnitude("alpha-max-beta-min", magn_var, magn_ref);
+
+  // Direction bins instead of the CORDIC
+  runEdge<binConfig<4> >(rarray, magn_var, angle_var, unwritten);
+  errors += checkDirection(4, angle_var, dx, dy, angle_ref);
+  runEdge<binConfig<8> >(rarray, magn_var, angle_var, unwritten);
+  errors += checkDirection(8, angle_var, dx, dy, angle_ref);
+
+  // Magnitude from the vectoring CORDIC, within one of the sqrt and within
+  // the angle quantization plus the residual rotation of the ac_atan2_cordic
+  // angle
+  int cordicErr = 0;
+  double maxAngErr = 0;
+  runEdge<magConfig<magCordic<10> > >(rarray, magn_var, angle_var, unwritten);
+  for (int i = 0; i < iH*iW; i++) {
+    double angErr = fabs(angle_var[i].to_double() - angle_hw[i].to_double());
+    maxAngErr = std::max(maxAngErr, angErr);
+    cordicErr += (abs(magn_var[i] - magn_hw[i]) > 1) || (angErr > 1.0/32);
+  }
+  printf("CORDIC (10 iterations): %d pixels off by more than one magnitude or angle LSB, max angle difference %f\n",
+         cordicErr, maxAngErr);
+  checkCordic(10, magn_var, angle_var, magn_hw, magn_ref, angle_ref);
+  errors += cordicErr;
+
+  // Single output builds, the output not built must stay empty
+  int magOnlyErr, angOnlyErr;
+  runEdge<outputConfig<edgeMagnitude> >(rarray, magn_var, angle_var, magOnlyErr);
+  for (int i = 0; i < iH*iW; i++) {
+    magOnlyErr += (magn_var[i] != magn_hw[i]);
+  }
+  runEdge<outputConfig<edgeAngle> >(rarray, magn_var, angle_var, angOnlyErr);
+  for (int i = 0; i < iH*iW; i++) {
+    angOnlyErr += (angle_var[i] != angle_hw[i]);
+  }
+  printf("Magnitude only build mismatches: %d\n", magOnlyErr);
+  printf("Angle only build mismatches: %d\n", angOnlyErr);
+  errors += magOnlyErr + angOnlyErr;
+
+  delete[] dx;
+  delete[] dy;
+  delete[] magn_ref;
+  delete[] angle_ref;
+  delete[] magn_hw;
+  delete[] magn_var;
+  delete[] angle_hw;
+  delete[] angle_var;
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  printf("%s: %d mismatches\n", errors ? "FAILED" : "PASSED", errors);
+  CCS_RETURN(errors ? 1 : 0);
+}
@@ -53,19 +53,19 @@ solution file remove [file join $sfd EdgeDetect_SinglePort_Programable_tb.cpp]
 solution file add [file join $sfd EdgeDetect_CircularBuf_tb.cpp] -type C++
 
 go analyze
-directive set -DESIGN_HIERARCHY {{EdgeDetect_CircularBuf<1296, 864>} {EdgeDetect_CircularBuf<1296, 864>::verticalDerivative} {EdgeDetect_CircularBuf<1296, 864>::horizontalDerivative} {EdgeDetect_CircularBuf<1296, 864>::magnitudeAngle}}
+directive set -DESIGN_HIERARCHY {{EdgeDetect_CircularBuf<1296, 864, circularBufConfig>} {EdgeDetect_CircularBuf<1296, 864, circularBufConfig>::verticalDerivative} {EdgeDetect_CircularBuf<1296, 864, circularBufConfig>::horizontalDerivative} {EdgeDetect_CircularBuf<1296, 864, circularBufConfig>::magnitudeAngle}}
 go compile
 go libraries
 directive set -CLOCKS {clk {-CLOCK_PERIOD 3.33 -CLOCK_EDGE rising -CLOCK_UNCERTAINTY 0.0 -CLOCK_HIGH_TIME 1.665 -RESET_SYNC_NAME rst -RESET_ASYNC_NAME arst_n -RESET_KIND sync -RESET_SYNC_ACTIVE high -RESET_ASYNC_ACTIVE low -ENABLE_ACTIVE high}}
 go assembly
-directive set /EdgeDetect_CircularBuf<1296,864>/verticalDerivative/core/line_buf0:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
-directive set /EdgeDetect_CircularBuf<1296,864>/verticalDerivative/core/line_buf1:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
-directive set /EdgeDetect_CircularBuf<1296,864>/verticalDerivative/core/VROW -PIPELINE_INIT_INTERVAL 1
-directive set /EdgeDetect_CircularBuf<1296,864>/horizontalDerivative/core/HROW -PIPELINE_INIT_INTERVAL 1
-directive set /EdgeDetect_CircularBuf<1296,864>/magnitudeAngle/core/MROW -PIPELINE_INIT_INTERVAL 1
-directive set /EdgeDetect_CircularBuf<1296,864>/magnitudeAngle/core/ac_math::ac_atan2_cordic<9,9,AC_TRN,AC_WRAP,9,9,AC_TRN,AC_WRAP,8,3,AC_TRN,AC_WRAP>:for -UNROLL yes
-directive set /EdgeDetect_CircularBuf<1296,864>/widthIn:rsc -MAP_TO_MODULE {[DirectInput]}
-directive set /EdgeDetect_CircularBuf<1296,864>/heightIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/verticalDerivative/core/line_buf0:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/verticalDerivative/core/line_buf1:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/verticalDerivative/core/VROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/horizontalDerivative/core/HROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/magnitudeAngle/core/MROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/magnitudeAngle/core/ac_math::ac_atan2_cordic<9,9,AC_TRN,AC_WRAP,9,9,AC_TRN,AC_WRAP,8,3,AC_TRN,AC_WRAP>:for -UNROLL yes
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/widthIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_CircularBuf<1296,864,circularBufConfig>/heightIn:rsc -MAP_TO_MODULE {[DirectInput]}
 go architect
 go extract
 go switch
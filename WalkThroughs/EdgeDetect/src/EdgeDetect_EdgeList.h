@@ -0,0 +1,188 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_EDGELIST_H_
+#define _INCLUDED_EDGEDETECT_EDGELIST_H_
+
+// Streaming sparse edge list output stage, chained after the magnitude and
+// angle outputs of the edge detect designs. Only pixels at or above threshIn
+// produce an {x, y, magnitude, angle} record, in raster order. The number
+// of records is written once at the end of every frame.
+//
+// EdgeDetect_CircularBufEdgeList fuses the stage into the circular buffer
+// design, so the dense magnitude and angle streams never leave the chip.
+
+#include <ac_fixed.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+#include "EdgeDetect_CircularBuf.h"
+#include <mc_scverify.h>
+
+// magT - input magnitude type, 9-bit unsigned by default
+// angT - input angle type, 3 integer and 5 fractional bits by default
+template <int imageWidth, int imageHeight, class magT = uint9, class angT = ac_fixed<8,3,true> >
+class EdgeDetect_EdgeList
+{
+  // Define some bit-accurate types to use in this model
+  typedef magT                   magType;      // unsigned magnitute
+  typedef angT                   angType;      // quantized angle -pi to pi
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+  typedef magType threshType;
+  typedef ac_int<ac::nbits<imageWidth*imageHeight>::val,false> countType; // records per frame
+
+  //--------------------------------------------------------------------------
+  // Struct: edgeRecord
+  //   One edge pixel, coordinates from the loop counters
+  struct edgeRecord
+  {
+    maxW    x;
+    maxH    y;
+    magType mag;
+    angType ang;
+  };
+
+  EdgeDetect_EdgeList() {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Compacts the magnitude and
+  //   angle streams into edge records.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<magType>    &magn,
+                      ac_channel<angType>    &angle,
+                      maxW                   &widthIn,
+                      maxH                   &heightIn,
+                      threshType             &threshIn,
+                      ac_channel<edgeRecord> &records,
+                      ac_channel<countType>  &count)
+  {
+    compactEdges(magn, angle, widthIn, heightIn, threshIn, records, count);
+  }
+
+protected:
+  //--------------------------------------------------------------------------
+  // Function: compactEdges
+  //   Write a record for every pixel at or above the threshold, then the
+  //   record count
+#pragma hls_design
+  void compactEdges(ac_channel<magType>    &magn_in,
+                    ac_channel<angType>    &angle_in,
+                    maxW                   &widthIn,
+                    maxH                   &heightIn,
+                    threshType             &threshIn,
+                    ac_channel<edgeRecord> &records,
+                    ac_channel<countType>  &count)
+  {
+    edgeRecord rec;
+    countType  num = 0;
+
+    LROW: for (maxH y = 0; ; y++) {
+      LCOL: for (maxW x = 0; ; x++) {
+        rec.x = x;
+        rec.y = y;
+        rec.mag = magn_in.read(); // Read streaming interfaces
+        rec.ang = angle_in.read();
+        if (rec.mag >= threshIn) {
+          records.write(rec); // Write streaming interface
+          num++;
+        }
+        // programmable width exit condition
+        if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      //programmable height exit condition
+      if (y == maxH(heightIn-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+    count.write(num); // end of frame
+  }
+
+};
+
+//----------------------------------------------------------------------------
+// Class: EdgeDetect_CircularBufEdgeList
+//   EdgeDetect_CircularBuf with the edge list compacted on chip. Records
+//   carry both magnitude and angle, so the full CircularBuf datapath is
+//   kept and only the records and the count leave the design.
+template <int imageWidth, int imageHeight, class cfg = circularBufConfig>
+class EdgeDetect_CircularBufEdgeList :
+  public EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg>,
+  public EdgeDetect_EdgeList<imageWidth, imageHeight,
+                             typename EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg>::magOutType,
+                             typename EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg>::angOutType>
+{
+  typedef EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg> edgeBase;
+  typedef EdgeDetect_EdgeList<imageWidth, imageHeight, typename edgeBase::magOutType,
+                              typename edgeBase::angOutType> listBase;
+  typedef typename edgeBase::pixelType pixelType;
+  typedef typename edgeBase::magType   magType;
+  typedef typename edgeBase::angType   angType;
+
+  static_assert(edgeBase::outputs == edgeBoth, "edge records need both magnitude and angle");
+
+  // Static interconnect channels (FIFOs) between blocks
+  ac_channel<magType> mag; // magnitude into compactEdges
+  ac_channel<angType> ang; // angle into compactEdges
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef typename edgeBase::maxW       maxW;
+  typedef typename edgeBase::maxH       maxH;
+  typedef typename listBase::threshType threshType;
+  typedef typename listBase::countType  countType;
+  typedef typename listBase::edgeRecord edgeRecord;
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. The EdgeDetect_CircularBuf
+  //   blocks followed by compactEdges.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<pixelType>  &dat_in,
+                      maxW                   &widthIn,
+                      maxH                   &heightIn,
+                      threshType             &threshIn,
+                      ac_channel<edgeRecord> &records,
+                      ac_channel<countType>  &count)
+  {
+    this->verticalDerivative(dat_in, widthIn, heightIn, this->dat, this->dy);
+    this->horizontalDerivative(this->dat, widthIn, heightIn, this->dx);
+    this->magnitudeAngle(this->dx, this->dy, widthIn, heightIn, mag, ang);
+    this->compactEdges(mag, ang, widthIn, heightIn, threshIn, records, count);
+  }
+};
+
+#endif
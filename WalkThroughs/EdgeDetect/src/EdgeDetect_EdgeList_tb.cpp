@@ -0,0 +1,223 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_CircularBuf.h"
+#include "EdgeDetect_EdgeList.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <mc_scverify.h>
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  typedef EdgeDetect_EdgeList<iW,iH> ListT;
+  typedef EdgeDetect_CircularBufEdgeList<iW,iH> FusedT;
+  EdgeDetect_Algorithm             inst0;
+  EdgeDetect_CircularBuf<iW,iH>    inst1;
+  ListT                            inst2;
+  FusedT                           inst3;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  EdgeDetect_CircularBuf<iW,iH>::maxW widthIn = iW;
+  EdgeDetect_CircularBuf<iW,iH>::maxH heightIn = iH;
+  ListT::maxW listWidthIn = iW;
+  ListT::maxH listHeightIn = iH;
+  ListT::threshType threshIn = 150;
+  FusedT::maxW fusedWidthIn = iW;
+  FusedT::maxH fusedHeightIn = iH;
+  FusedT::threshType fusedThreshIn = 150;
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>               dat_in;
+  ac_channel<uint9>               magn;
+  ac_channel<ac_fixed<8,3> >      angle;
+  ac_channel<ListT::edgeRecord>   records;
+  ac_channel<ListT::countType>    count;
+  ac_channel<uint8>               fused_in;
+  ac_channel<FusedT::edgeRecord>  fusedRecords;
+  ac_channel<FusedT::countType>   fusedCount;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+  int *magn_hw = new int[iH*iW];
+  double *angle_hw = new double[iH*iW];
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      fused_in.write(rarray[cnt]);
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1.run(dat_in,widthIn,heightIn,magn,angle);
+
+  // Capture the edge detect output and chain it into the edge list stage
+  ac_channel<uint9>            magn_list;
+  ac_channel<ac_fixed<8,3> >   angle_list;
+  for (int i = 0; i < iH*iW; i++) {
+    uint9 m = magn.read();
+    ac_fixed<8,3> a = angle.read();
+    magn_hw[i] = m;
+    angle_hw[i] = a.to_double();
+    magn_list.write(m);
+    angle_list.write(a);
+  }
+  inst2.run(magn_list,angle_list,listWidthIn,listHeightIn,threshIn,records,count);
+  // Fused design, must match the chained stages record for record
+  inst3.run(fused_in,fusedWidthIn,fusedHeightIn,fusedThreshIn,fusedRecords,fusedCount);
+
+  // Expand the records back into an image and check them against the
+  // bit-accurate outputs
+  unsigned long numRecords = 0;
+  unsigned long mismatches = 0;
+  int last = -1;
+  std::vector<ListT::edgeRecord> chained;
+  for (int i = 0; i < iH*iW; i++) {
+    rarray[i] = 0;
+    garray[i] = ((int)magn_orig[i] >= threshIn.to_int()) ? 255 : 0;
+  }
+  while (records.available(1)) {
+    ListT::edgeRecord rec = records.read();
+    int i = rec.y.to_int()*iW + rec.x.to_int();
+    mismatches += (i <= last) || (rec.mag.to_int() != magn_hw[i]) || (rec.ang.to_double() != angle_hw[i]);
+    last = i;
+    rarray[i] = 255;
+    chained.push_back(rec);
+    numRecords++;
+  }
+  // Every pixel at or above the threshold needs a record
+  unsigned long expected = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    expected += (magn_hw[i] >= threshIn.to_int());
+  }
+  unsigned long frameCount = count.read().to_int64();
+  unsigned long fusedMismatches = 0;
+  for (unsigned long r = 0; r < chained.size(); r++) {
+    FusedT::edgeRecord rec = fusedRecords.read();
+    fusedMismatches += (rec.x != chained[r].x) || (rec.y != chained[r].y) ||
+                       (rec.mag != chained[r].mag) || (rec.ang != chained[r].ang);
+  }
+  fusedMismatches += fusedRecords.size(); // records beyond the frame
+  fusedMismatches += ((unsigned long)fusedCount.read().to_int64() != frameCount);
+
+  printf("Edge threshold %d\n", threshIn.to_int());
+  printf("Edge records %lu, frame count %lu, expected %lu\n", numRecords, frameCount, expected);
+  printf("Record mismatches %lu, fused design mismatches %lu\n", mismatches, fusedMismatches);
+  printf("Record bits %d, edge list %lu bytes per frame, magnitude and angle %d bytes per frame\n",
+         ListT::maxW::width + ListT::maxH::width + 9 + 8,
+         numRecords * (ListT::maxW::width + ListT::maxH::width + 9 + 8) / 8, iH*iW*17/8);
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (magn_hw);
+  delete (angle_hw);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  if (mismatches || fusedMismatches || (numRecords != expected) || (frameCount != expected)) {
+    cout << "FAILED" << endl;
+    CCS_RETURN(1);
+  }
+  cout << "PASSED" << endl;
+  CCS_RETURN(0);
+}
@@ -0,0 +1,180 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_EDGEPACK_H_
+#define _INCLUDED_EDGEDETECT_EDGEPACK_H_
+
+// Streaming binary edge map output stage, chained after the magnitude output
+// of the edge detect designs (or after EdgeDetect_NMS/EdgeDetect_Hysteresis).
+// Each pixel at or above threshIn is an edge. The 1-bit decisions are packed
+// LSB first into wordBits-bit words. Every line starts a new word, and the
+// last word of a line is zero padded.
+//
+// EdgeDetect_CircularBufEdgePack fuses the stage into the circular buffer
+// design, so only the packed words leave the chip and the angle CORDIC is
+// not built.
+
+#include <ac_int.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+#include "EdgeDetect_CircularBuf.h"
+#include <mc_scverify.h>
+
+// wordBits - output word width, 32 or 64
+// inType   - input stream type, uint9 magnitude by default
+template <int imageWidth, int imageHeight, int wordBits = 32, class inType = uint9>
+class EdgeDetect_EdgePack
+{
+  static_assert((wordBits == 32) || (wordBits == 64), "EdgeDetect_EdgePack word width must be 32 or 64");
+
+  // Define some bit-accurate types to use in this model
+  typedef ac_int<ac::nbits<wordBits-1>::val,false> bitIdx; // bit position in the output word
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+  typedef inType threshType;
+  typedef ac_int<wordBits,false> wordType; // packed edge decisions
+  enum { lineWords = (imageWidth + wordBits - 1) / wordBits };
+  EdgeDetect_EdgePack() {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Thresholds the input stream
+  //   into packed edge words.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<inType>    &dat_in,
+                      maxW                  &widthIn,
+                      maxH                  &heightIn,
+                      threshType            &threshIn,
+                      ac_channel<wordType>  &edgeWords)
+  {
+    packEdges(dat_in, widthIn, heightIn, threshIn, edgeWords);
+  }
+
+protected:
+  //--------------------------------------------------------------------------
+  // Function: packEdges
+  //   Threshold each pixel and collect the decisions into output words
+#pragma hls_design
+  void packEdges(ac_channel<inType>   &dat_in,
+                 maxW                 &widthIn,
+                 maxH                 &heightIn,
+                 threshType           &threshIn,
+                 ac_channel<wordType> &edgeWords)
+  {
+    wordType word = 0;
+    bitIdx   bit;
+    bool     edge;
+
+    PROW: for (maxH y = 0; ; y++) {
+      PCOL: for (maxW x = 0; ; x++) {
+        edge = (dat_in.read() >= threshIn); // Read streaming interface
+        bit = x.template slc<bitIdx::width>(0);
+        word.set_slc(bit, ac_int<1,false>(edge));
+        // Write a full word, or the last word of the line
+        if ((bit == wordBits-1) | (x == maxW(widthIn-1))) {
+          edgeWords.write(word); // Write streaming interface
+          word = 0;
+        }
+        // programmable width exit condition
+        if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      //programmable height exit condition
+      if (y == maxH(heightIn-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+
+};
+
+//----------------------------------------------------------------------------
+// Struct: edgePackConfig
+//   EdgeDetect_CircularBuf options of the fused edge map design, the edge
+//   decision only needs the magnitude
+struct edgePackConfig : circularBufConfig
+{
+  enum { outputs = edgeMagnitude };
+};
+
+//----------------------------------------------------------------------------
+// Class: EdgeDetect_CircularBufEdgePack
+//   EdgeDetect_CircularBuf with the magnitude packed into edge words on chip.
+//   The output is 1 bit per pixel instead of 17 bits of magnitude and angle,
+//   the magnitude stream stays between two blocks of the same design.
+template <int imageWidth, int imageHeight, int wordBits = 32, class cfg = edgePackConfig>
+class EdgeDetect_CircularBufEdgePack :
+  public EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg>,
+  public EdgeDetect_EdgePack<imageWidth, imageHeight, wordBits,
+                             typename EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg>::magOutType>
+{
+  typedef EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg> edgeBase;
+  typedef EdgeDetect_EdgePack<imageWidth, imageHeight, wordBits, typename edgeBase::magOutType> packBase;
+  typedef typename edgeBase::pixelType pixelType;
+  typedef typename edgeBase::magType   magType;
+  typedef typename edgeBase::angType   angType;
+
+  static_assert(edgeBase::outputs == edgeMagnitude, "the edge map only needs the magnitude, build it with outputs = edgeMagnitude");
+
+  // Static interconnect channels (FIFOs) between blocks
+  ac_channel<magType> mag; // magnitude into packEdges
+  ac_channel<angType> ang; // never written, magnitude only build
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef typename edgeBase::maxW     maxW;
+  typedef typename edgeBase::maxH     maxH;
+  typedef typename packBase::threshType threshType;
+  typedef typename packBase::wordType   wordType;
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. The EdgeDetect_CircularBuf
+  //   blocks followed by packEdges.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<pixelType> &dat_in,
+                      maxW                  &widthIn,
+                      maxH                  &heightIn,
+                      threshType            &threshIn,
+                      ac_channel<wordType>  &edgeWords)
+  {
+    this->verticalDerivative(dat_in, widthIn, heightIn, this->dat, this->dy);
+    this->horizontalDerivative(this->dat, widthIn, heightIn, this->dx);
+    this->magnitudeAngle(this->dx, this->dy, widthIn, heightIn, mag, ang);
+    this->packEdges(mag, widthIn, heightIn, threshIn, edgeWords);
+  }
+};
+
+#endif
@@ -0,0 +1,44 @@
+#------------------------------------------------------------
+# Sliding Window Walkthrough - Bit-packed edge map
+#------------------------------------------------------------
+
+# Establish the location of this script and use it to reference all
+# other files in this example
+set sfd [file dirname [info script]]
+  
+# Reset the options to the factory defaults
+options defaults
+options set /Input/CppStandard c++11
+
+project new
+
+flow package require /SCVerify
+flow package option set /SCVerify/USE_CCS_BLOCK true
+flow package option set /SCVerify/INVOKE_ARGS "[file join $sfd image people_gray.bmp] out_algorithm.bmp out_hw.bmp"
+
+solution file add {$MGC_HOME/shared/include/bmpUtil/bmp_io.cpp} -type C++ -exclude true
+solution file add [file join $sfd EdgeDetect_EdgePack_tb.cpp] -type C++
+options set Output/OutputVHDL false
+
+solution options set /ComponentLibs/SearchPath $sfd -append
+
+go analyze
+directive set -DESIGN_HIERARCHY {{EdgeDetect_CircularBufEdgePack<1296, 864, 32, edgePackConfig>} {EdgeDetect_CircularBuf<1296, 864, edgePackConfig>::verticalDerivative} {EdgeDetect_CircularBuf<1296, 864, edgePackConfig>::horizontalDerivative} {EdgeDetect_CircularBuf<1296, 864, edgePackConfig>::magnitudeAngle} {EdgeDetect_EdgePack<1296, 864, 32, ac_int<9, false> >::packEdges}}
+go compile
+solution library add nangate-45nm_beh -file {$MGC_HOME/pkgs/siflibs/nangate/nangate-45nm_beh.lib} -- -rtlsyntool OasysRTL
+solution library add ram_1k_16_sp 
+
+go libraries
+directive set -CLOCKS {clk {-CLOCK_PERIOD 3.33 -CLOCK_EDGE rising -CLOCK_UNCERTAINTY 0.0 -CLOCK_HIGH_TIME 1.665 -RESET_SYNC_NAME rst -RESET_ASYNC_NAME arst_n -RESET_KIND sync -RESET_SYNC_ACTIVE high -RESET_ASYNC_ACTIVE low -ENABLE_ACTIVE high}}
+go assembly
+directive set /EdgeDetect_CircularBufEdgePack<1296,864,32,edgePackConfig>/verticalDerivative/core/line_buf0:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
+directive set /EdgeDetect_CircularBufEdgePack<1296,864,32,edgePackConfig>/verticalDerivative/core/line_buf1:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
+directive set /EdgeDetect_CircularBufEdgePack<1296,864,32,edgePackConfig>/verticalDerivative/core/VROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBufEdgePack<1296,864,32,edgePackConfig>/horizontalDerivative/core/HROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBufEdgePack<1296,864,32,edgePackConfig>/magnitudeAngle/core/MROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBufEdgePack<1296,864,32,edgePackConfig>/packEdges/core/PROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_CircularBufEdgePack<1296,864,32,edgePackConfig>/widthIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_CircularBufEdgePack<1296,864,32,edgePackConfig>/heightIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_CircularBufEdgePack<1296,864,32,edgePackConfig>/threshIn:rsc -MAP_TO_MODULE {[DirectInput]}
+go architect
+go extract
@@ -0,0 +1,231 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_CircularBuf.h"
+#include "EdgeDetect_EdgePack.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <mc_scverify.h>
+
+// Unpack one frame of edge words and count mismatches against the
+// thresholded magnitude
+template <class packT>
+static unsigned long checkPacked(ac_channel<typename packT::wordType> &edgeWords, const int *magn, int w, int h, int thresh,
+                                 unsigned long &numWords, unsigned char *edgeOut)
+{
+  unsigned long mismatches = 0;
+  numWords = 0;
+  for (int y = 0; y < h; y++) {
+    typename packT::wordType word = 0;
+    for (int x = 0; x < w; x++) {
+      if ((x % packT::wordType::width) == 0) {
+        word = edgeWords.read();
+        numWords++;
+      }
+      int hw = word[x % packT::wordType::width];
+      mismatches += (hw != (magn[y*w+x] >= thresh));
+      edgeOut[y*w+x] = hw ? 255 : 0;
+    }
+  }
+  mismatches += edgeWords.size(); // words beyond the frame
+  return mismatches;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  typedef EdgeDetect_EdgePack<iW,iH,32> Pack32;
+  typedef EdgeDetect_EdgePack<iW,iH,64> Pack64;
+  typedef EdgeDetect_CircularBufEdgePack<iW,iH,32> Fused32;
+  EdgeDetect_Algorithm             inst0;
+  EdgeDetect_CircularBuf<iW,iH>    inst1;
+  Pack32                           inst2;
+  Pack64                           inst3;
+  Fused32                          inst4;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  EdgeDetect_CircularBuf<iW,iH>::maxW widthIn = iW;
+  EdgeDetect_CircularBuf<iW,iH>::maxH heightIn = iH;
+  Pack32::maxW packWidthIn = iW;
+  Pack32::maxH packHeightIn = iH;
+  Pack64::maxW pack64WidthIn = iW;
+  Pack64::maxH pack64HeightIn = iH;
+  Pack32::threshType threshIn = 60;
+  Pack64::threshType thresh64In = 60;
+  Fused32::maxW fusedWidthIn = iW;
+  Fused32::maxH fusedHeightIn = iH;
+  Fused32::threshType fusedThreshIn = 60;
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+  ac_channel<uint9>            magn32;
+  ac_channel<uint9>            magn64;
+  ac_channel<Pack32::wordType> edgeWords32;
+  ac_channel<Pack64::wordType> edgeWords64;
+  ac_channel<uint8>            fused_in;
+  ac_channel<Fused32::wordType> edgeWordsFused;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+  int *magn_hw = new int[iH*iW];
+  unsigned char *edge64 = new unsigned char[iH*iW];
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      fused_in.write(rarray[cnt]);
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1.run(dat_in,widthIn,heightIn,magn,angle);
+
+  // Chain the magnitude into both packing stages, the angle is not needed
+  for (int i = 0; i < iH*iW; i++) {
+    uint9 m = magn.read();
+    angle.read();
+    magn_hw[i] = m;
+    magn32.write(m);
+    magn64.write(m);
+  }
+  inst2.run(magn32,packWidthIn,packHeightIn,threshIn,edgeWords32);
+  inst3.run(magn64,pack64WidthIn,pack64HeightIn,thresh64In,edgeWords64);
+  // Fused design, must match the chained stages word for word
+  inst4.run(fused_in,fusedWidthIn,fusedHeightIn,fusedThreshIn,edgeWordsFused);
+
+  unsigned long words32, words64, wordsFused;
+  unsigned char *edgeFused = new unsigned char[iH*iW];
+  unsigned long err32 = checkPacked<Pack32>(edgeWords32, magn_hw, iW, iH, threshIn.to_int(), words32, rarray);
+  unsigned long err64 = checkPacked<Pack64>(edgeWords64, magn_hw, iW, iH, thresh64In.to_int(), words64, edge64);
+  unsigned long errFused = checkPacked<Pack32>(edgeWordsFused, magn_hw, iW, iH, fusedThreshIn.to_int(), wordsFused, edgeFused);
+
+  // Threshold the algorithm magnitude for the reference image
+  float sumErr = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    int alg = ((int)magn_orig[i] >= threshIn.to_int());
+    sumErr += abs(alg - (rarray[i] ? 1 : 0));
+    garray[i] = alg ? 255 : 0;
+  }
+
+  printf("Edge threshold %d\n", threshIn.to_int());
+  printf("Edge map: Manhattan norm per pixel %f\n",sumErr/(iH*iW));
+  printf("32-bit words: %lu mismatches, %lu words, %f bits per pixel\n", err32, words32, 32.0*words32/(iH*iW));
+  printf("64-bit words: %lu mismatches, %lu words, %f bits per pixel\n", err64, words64, 64.0*words64/(iH*iW));
+  printf("Fused 32-bit words: %lu mismatches, %lu words\n", errFused, wordsFused);
+  printf("Magnitude and angle output: 17 bits per pixel\n");
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (magn_hw);
+  delete (edge64);
+  delete (edgeFused);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  if (err32 + err64 + errFused) {
+    cout << "FAILED" << endl;
+    CCS_RETURN(1);
+  }
+  cout << "PASSED" << endl;
+  CCS_RETURN(0);
+}
@@ -0,0 +1,406 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_FRAMED_H_
+#define _INCLUDED_EDGEDETECT_FRAMED_H_
+
+// Revision History
+//    Rev 1 - Coding of edge detection algorithm in C++
+//    Rev 2 - Converted to using bit-accurate data types
+//            Calculated bit growth for internal variables
+//            Quantized angle values for 5 fractional bits -pi to pi
+//    Rev 3 - Switch to using HLSLIBS ac_math library for high performance
+//            math functions.
+//            Add support for verification using SCVerify
+//    Rev 4 - Refinining memory architecture for 1PPC
+//    Rev 5 - Modularized into hierarchy for performance
+//    Rev 6 - Recode to use single-port memories
+//    Rev 7 - Recode to make the design programmable for image size
+//    Rev 8 - Recode to use single-port memories in circular fashion
+//    Rev 9 - Recode to carry frame and line boundaries in-band with the
+//            pixel stream so the resolution can change every frame
+//            Resynchronize on start of frame, clamp lines to imageWidth
+
+#include <ac_fixed.h>
+// This is Catapult's math library implementation, see docs for details
+#include <ac_math/ac_sqrt_pwl.h>
+#include <ac_math/ac_atan2_cordic.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+
+// Include constant kernel definition
+#include "edge_defs.h"
+#include <mc_scverify.h>
+
+//----------------------------------------------------------------------------
+// Struct: frameBeat
+//   One beat of an AXI4-Stream video style interface. The sideband flags
+//   travel with the data through every block of the pipeline:
+//     sof - start of frame, set on the first pixel of a frame (TUSER)
+//     eol - end of line, set on the last pixel of every line (TLAST)
+//     eof - end of frame, set together with eol on the last pixel of a frame
+template <typename T>
+struct frameBeat
+{
+  T    data;
+  bool sof;
+  bool eol;
+  bool eof;
+};
+
+template <int imageWidth, int imageHeight>
+class EdgeDetect_Framed
+{
+  // Define some bit-accurate types to use in this model
+  typedef uint8                  pixelType;    // input pixel is 0-255
+  typedef uint16                 pixelType2x;  // two pixels packed
+  typedef int9                   gradType;     // Derivative is max range -255 to 255
+  typedef uint18                 sqType;       // Result of 9-bit x 9-bit
+  typedef ac_fixed<19,19,false>  sumType;      // Result of 18-bit + 18-bit fixed pt integer for squareroot
+  typedef uint9                  magType;      // 9-bit unsigned magnitute result
+  typedef ac_fixed<8,3,true>     angType;      // 3 integer bit, 5 fractional bits for quantized angle -pi to pi
+
+public:
+  // Pixel and result beats carrying the frame/line sideband flags
+  typedef frameBeat<pixelType>   pixelBeat;
+  typedef frameBeat<gradType>    gradBeat;
+  typedef frameBeat<magType>     magBeat;
+  typedef frameBeat<angType>     angBeat;
+
+  //Compute number of bits for max image size count, used internally
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+
+private:
+  // Static interconnect channels (FIFOs) between blocks
+  ac_channel<gradBeat>       dy;
+  ac_channel<gradBeat>       dx;
+  ac_channel<pixelBeat>      dat; // channel for passing input pixels to horizontalDerivative
+  bool                       pp;  // flag for rotating the buffers
+  pixelBeat                  sofBeat; // start of frame beat that cut the previous frame short
+  bool                       sofHeld; // sofBeat starts the next frame
+
+public:
+  EdgeDetect_Framed():pp(false),sofHeld(false) {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Combines vertical and
+  //   horizontal derivative and magnitude/angle computation.
+  //   Processes one frame per call. The frame size is taken from the eol/eof
+  //   flags on dat_in and may change from one frame to the next, up to
+  //   imageWidth x imageHeight. Lines of odd width take one extra cycle at
+  //   the end of the line to store their last pixel.
+  //   Malformed input is resynchronized, the output flags are always those
+  //   of a well formed frame:
+  //     - beats before the first sof are dropped
+  //     - a sof inside the first line restarts the frame on that beat
+  //     - a sof in a later line ends the frame at the previous line, the
+  //       beat starts the next frame
+  //     - lines are clamped to imageWidth pixels, the rest is dropped
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<pixelBeat> &dat_in,
+                      ac_channel<magBeat>   &magn,
+                      ac_channel<angBeat>   &angle)
+  {
+    verticalDerivative(dat_in, dat, dy);
+    horizontalDerivative(dat, dx);
+    magnitudeAngle(dx, dy, magn, angle);
+  }
+
+private:
+  //--------------------------------------------------------------------------
+  // Function: verticalDerivative
+  //   Compute the vertical derivative on the input data
+#pragma hls_design
+  void verticalDerivative(ac_channel<pixelBeat> &dat_in,
+                          ac_channel<pixelBeat> &dat_out,
+                          ac_channel<gradBeat>  &dy)
+  {
+    // Line buffers store pixel line history - Mapped to RAM
+    pixelType2x line_buf0[(imageWidth+1)/2];
+    pixelType2x line_buf1[(imageWidth+1)/2];
+    pixelType2x rdbuf0_pix, rdbuf1_pix;
+    pixelType2x wrbuf0_pix;
+    pixelType pix0, pix1, pix2;
+    gradType pix;
+    pixelBeat inBeat;
+    pixelBeat datBeat;
+    gradBeat  dyBeat;
+    bool      eol;
+    bool      padCol;           // extra column after an odd width line, no input or output
+    bool      firstRow = true;  // ramp-up row, nothing is output
+    bool      topRow = false;   // first output row
+    bool      rampRow = false;  // extra row after the end of frame to ramp-down window
+    bool      restart = false;  // first line cut short by a start of frame
+    bool      haveBeat;         // inBeat is read but not used yet
+    maxW      lastCol = 0;      // last column of the previous line, used on the ramp-down row
+
+    inBeat.data = 0;
+    inBeat.sof = false;
+    inBeat.eol = false;
+    inBeat.eof = false;
+    // Start on a start of frame beat, which may have ended the previous frame
+    if (sofHeld) {
+      inBeat = sofBeat;
+      sofHeld = false;
+    }
+    VSOF: while (!inBeat.sof) { // drop beats up to the start of frame
+      inBeat = dat_in.read(); // Read streaming interface
+    }
+    haveBeat = true;
+
+    // Line and frame ends come from the sideband flags, no loop upperbounds
+    VROW: for (maxH y = 0;; y++) { // One extra iteration to ramp-up window
+      padCol = false;
+      VCOL: for (maxW x = 0;; x++) {
+        if (!rampRow & !padCol) {
+          if (!haveBeat) {
+            inBeat = dat_in.read(); // Read streaming interface
+          }
+          haveBeat = false;
+          // Start of frame inside the frame, the frame was cut short
+          if (inBeat.sof & !(firstRow & (x == 0))) {
+            if (firstRow) { // nothing output yet, restart on this beat
+              restart = true;
+              haveBeat = true;
+              break;
+            }
+            // End the frame at the previous line, hold the beat for the next frame
+            rampRow = true;
+            sofBeat = inBeat;
+            sofHeld = true;
+          }
+          pix0 = inBeat.data;
+        }
+        // Lines longer than imageWidth are clamped
+        if (!padCol) {
+          eol = rampRow ? (x >= lastCol) : (inBeat.eol | (x == imageWidth-1));
+        }
+        // Write data cache, write lower 8 on even iterations of COL loop, upper 8 on odd
+        if ( (x&1) == 0 ) {
+          wrbuf0_pix.set_slc(0,pix0);
+        } else {
+          wrbuf0_pix.set_slc(8,pix0);
+        }
+        // Read line buffers into read buffer caches on even iterations of COL loop
+        if ( (x&1) == 0 ) {
+          // pp controls which buffer is read as upper, which as lower
+          rdbuf1_pix = pp ? line_buf1[x/2] : line_buf0[x/2];
+          rdbuf0_pix = pp ? line_buf0[x/2] : line_buf1[x/2];
+        } else { // Write line buffer caches on odd iterations of COL loop
+          // Only one buffer is ever written based on pp
+          if (pp)
+            line_buf1[x/2] = wrbuf0_pix; // store current line
+          else
+            line_buf0[x/2] = wrbuf0_pix; // store current line
+        }
+        // Get 8-bit data from read buffer caches, lower 8 on even iterations of COL loop
+        pix2 = ((x&1)==0) ? rdbuf1_pix.slc<8>(0) : rdbuf1_pix.slc<8>(8);
+        pix1 = ((x&1)==0) ? rdbuf0_pix.slc<8>(0) : rdbuf0_pix.slc<8>(8);
+
+        // Boundary condition processing
+        if (topRow) {
+          pix2 = pix1; // top boundary (replicate pix1 up to pix2)
+        }
+        if (rampRow) {
+          pix0 = pix1; // bottom boundary (replicate pix1 down to pix0)
+        }
+
+        // Calculate derivative
+        pix = edgeKernel::apply(pix2, pix1, pix0);
+
+        if (!firstRow & !padCol) { // Write streaming interfaces, flags follow the delayed line
+          datBeat.data = pix1;
+          datBeat.sof  = topRow & (x == 0);
+          datBeat.eol  = eol;
+          datBeat.eof  = rampRow & eol;
+          dyBeat.data  = pix;
+          dyBeat.sof   = datBeat.sof;
+          dyBeat.eol   = datBeat.eol;
+          dyBeat.eof   = datBeat.eof;
+          dat_out.write(datBeat); // Pass thru original data
+          dy.write(dyBeat); // derivative output
+        }
+        // Rotate the buffers and exit at the end of every line, a line
+        // ending on an even column runs one more column to write its last
+        // pixel pair
+        if (eol & (padCol | ((x&1) == 1))) {
+          pp = !pp;
+          lastCol = padCol ? maxW(x-1) : x;
+          break;
+        }
+        padCol = eol;
+      }
+      // Exit after the ramp-down row, which follows the end of frame
+      if (rampRow)
+        break;
+      if (!restart) {
+        // Drop the rest of a clamped line, up to its end or a start of frame
+        if (!inBeat.eol) {
+          VDROP: do {
+            inBeat = dat_in.read(); // Read streaming interface
+          } while (!inBeat.eol & !inBeat.sof);
+          if (inBeat.sof) {
+            sofBeat = inBeat;
+            sofHeld = true;
+          }
+        }
+        rampRow = inBeat.eof | sofHeld;
+        topRow = firstRow;
+        firstRow = false;
+      }
+      restart = false;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: horizontalDerivative
+  //   Compute the horizontal derivative on the input data
+#pragma hls_design
+  void horizontalDerivative(ac_channel<pixelBeat> &dat_in,
+                            ac_channel<gradBeat>  &dx)
+  {
+    // pixel buffers store pixel history
+    pixelType pix_buf0;
+    pixelType pix_buf1;
+
+    pixelType pix0 = 0;
+    pixelType pix1 = 0;
+    pixelType pix2 = 0;
+
+    gradType  pix;
+    pixelBeat inBeat;
+    gradBeat  dxBeat;
+    bool      sof = false;  // start of frame flag of the first pixel in the line
+    bool      lineDone;     // end of line has been read, ramp-down iteration
+
+    inBeat.data = 0;
+    inBeat.sof = false;
+    inBeat.eol = false;
+    inBeat.eof = false;
+
+    HROW: for (maxH y = 0; ; y++) {
+      lineDone = false;
+      HCOL: for (maxW x = 0; ; x++) { // One extra iteration to ramp-up window
+        pix2 = pix_buf1;
+        pix1 = pix_buf0;
+        if (!lineDone) {
+          inBeat = dat_in.read(); // Read streaming interface
+          pix0 = inBeat.data;
+        }
+        if (x == 0) {
+          sof = inBeat.sof;
+        }
+        if (x == 1) {
+          pix2 = pix1; // left boundary condition (replicate pix1 left to pix2)
+        }
+        if (lineDone) {
+          pix0 = pix1; // right boundary condition (replicate pix1 right to pix0)
+        }
+
+        pix_buf1 = pix_buf0;
+        pix_buf0 = pix0;
+        // Calculate derivative
+        pix = edgeKernel::apply(pix2, pix1, pix0);
+
+        if (x != 0) { // Write streaming interface
+          dxBeat.data = pix;
+          dxBeat.sof  = sof & (x == 1);
+          dxBeat.eol  = lineDone;
+          dxBeat.eof  = lineDone & inBeat.eof;
+          dx.write(dxBeat); // derivative out
+        }
+        // exit one iteration after the end of line pixel
+        if (lineDone)
+          break;
+        lineDone = inBeat.eol;
+      }
+      // exit at the end of frame
+      if (inBeat.eof)
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: magnitudeAngle
+  //   Compute the magnitute and angle based on the horizontal and vertical
+  //   derivative results
+#pragma hls_design
+  void magnitudeAngle(ac_channel<gradBeat> &dx_in,
+                      ac_channel<gradBeat> &dy_in,
+                      ac_channel<magBeat>  &magn,
+                      ac_channel<angBeat>  &angle)
+  {
+    gradBeat dxBeat, dyBeat;
+    magBeat magnBeat;
+    angBeat angleBeat;
+    sqType dx_sq;
+    sqType dy_sq;
+    sumType sum; // fixed point integer for sqrt
+    angType at;
+    ac_fixed<16,9,false> sq_rt; // square-root return type
+
+    MROW: for (maxH y = 0; ; y++) {
+      MCOL: for (maxW x = 0; ; x++) {
+        dxBeat = dx_in.read();
+        dyBeat = dy_in.read();
+        dx_sq = dxBeat.data * dxBeat.data;
+        dy_sq = dyBeat.data * dyBeat.data;
+        sum = dx_sq + dy_sq;
+        // Catapult's math library piecewise linear implementation of sqrt and atan2
+        ac_math::ac_sqrt_pwl(sum,sq_rt);
+        magnBeat.data = sq_rt.to_uint();
+        magnBeat.sof  = dxBeat.sof;
+        magnBeat.eol  = dxBeat.eol;
+        magnBeat.eof  = dxBeat.eof;
+        magn.write(magnBeat);
+        ac_math::ac_atan2_cordic((ac_fixed<9,9>)dyBeat.data, (ac_fixed<9,9>)dxBeat.data, at);
+        angleBeat.data = at;
+        angleBeat.sof  = dxBeat.sof;
+        angleBeat.eol  = dxBeat.eol;
+        angleBeat.eof  = dxBeat.eof;
+        angle.write(angleBeat);
+        // end of line exit condition
+        if (dxBeat.eol)
+          break;
+      }
+      // end of frame exit condition
+      if (dxBeat.eof)
+        break;
+    }
+  }
+
+};
+
+#endif
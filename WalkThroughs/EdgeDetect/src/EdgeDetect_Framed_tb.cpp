@@ -0,0 +1,302 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_Framed.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <mc_scverify.h>
+
+//----------------------------------------------------------------------------
+// Function: writeFrame
+//   Write a w x h frame cropped from the top-left of an imgW wide image,
+//   columns past imgW repeat the image. With cutRow >= 0 the frame stops
+//   before pixel (cutRow, cutCol) and has no end of frame.
+template <class beatT>
+static void writeFrame(ac_channel<beatT> &ch, const unsigned char *img, int imgW, int w, int h,
+                       int cutRow = -1, int cutCol = 0)
+{
+  beatT pixBeat;
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      if ((y == cutRow) && (x == cutCol)) {
+        return;
+      }
+      pixBeat.data = img[y*imgW + (x % imgW)];
+      pixBeat.sof  = (y == 0) && (x == 0);
+      pixBeat.eol  = (x == w-1);
+      pixBeat.eof  = (x == w-1) && (y == h-1);
+      ch.write(pixBeat);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Function: compareFrame
+//   Read a w x h output frame from the design and the reference design,
+//   count flag errors of the design and data mismatches in the first
+//   checkRows rows
+template <class magT, class angT>
+static int compareFrame(ac_channel<magT> &magn, ac_channel<angT> &angle,
+                        ac_channel<magT> &refMagn, ac_channel<angT> &refAngle,
+                        int w, int h, int checkRows)
+{
+  int errors = 0;
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      magT m = magn.read();
+      angT a = angle.read();
+      magT rm = refMagn.read();
+      angT ra = refAngle.read();
+      bool sof = (y == 0) && (x == 0);
+      bool eol = (x == w-1);
+      bool eof = eol && (y == h-1);
+      errors += (m.sof != sof) || (m.eol != eol) || (m.eof != eof) ||
+                (a.sof != sof) || (a.eol != eol) || (a.eof != eof);
+      if (y < checkRows) {
+        errors += (m.data != rm.data) || (a.data != ra.data);
+      }
+    }
+  }
+  return errors + magn.size() + angle.size(); // beats beyond the frame
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  typedef EdgeDetect_Framed<iW,iH> EdgeDetect;
+  EdgeDetect                       inst1;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  // Frame sequence, the resolution changes from frame to frame without
+  // reprogramming or draining the design, odd widths included
+  const int numFrames = 4;
+  const int frameW[numFrames] = {iW, 640, 333, iW};
+#ifndef POWER
+  const int frameH[numFrames] = {iH, 480, 201, iH};
+#else
+  const int frameH[numFrames] = {30, 20, 15, 30};//use less rows for power analysis
+#endif
+  const int frameX[numFrames] = {0, 328, 101, 0}; // crop offset into the input image
+  const int frameY[numFrames] = {0, 192, 77, 0};
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+  unsigned char *out_hw = new unsigned char[iH*iW]; // bit-accurate output, rarray stays the input
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<EdgeDetect::pixelBeat>  dat_in;
+  ac_channel<EdgeDetect::magBeat>    magn;
+  ac_channel<EdgeDetect::angBeat>    angle;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+
+  int flagErr = 0;
+  int magErr = 0;
+  for (int f = 0; f < numFrames; f++) {
+    const int fW = frameW[f];
+    const int fH = frameH[f];
+    EdgeDetect_Algorithm inst0(fW,fH);
+    EdgeDetect::pixelBeat pixBeat;
+
+    unsigned cnt = 0;
+    for (int y = 0; y < fH; y++) {
+      for (int x = 0; x < fW; x++) {
+        pixBeat.data = rarray[(y+frameY[f])*iW + x+frameX[f]]; // just using red component (pseudo monochrome)
+        pixBeat.sof  = (y == 0) && (x == 0);
+        pixBeat.eol  = (x == fW-1);
+        pixBeat.eof  = (x == fW-1) && (y == fH-1);
+        dat_in.write(pixBeat);
+        dat_in_orig[cnt] = pixBeat.data.to_uint();
+        cnt++;
+      }
+    }
+
+    cout << "Running frame " << f << " (" << fW << "x" << fH << ")" << endl;
+
+    inst0.run(dat_in_orig,magn_orig,angle_orig);
+    inst1.run(dat_in,magn,angle);
+
+    cnt = 0;
+    float sumErr = 0;
+    float sumAngErr = 0;
+    for (int y = 0; y < fH; y++) {
+      for (int x = 0; x < fW; x++) {
+        EdgeDetect::magBeat magnBeat = magn.read();
+        EdgeDetect::angBeat angleBeat = angle.read();
+        // Sideband flags must come out aligned with the frame that went in
+        bool sof = (y == 0) && (x == 0);
+        bool eol = (x == fW-1);
+        bool eof = eol && (y == fH-1);
+        if ((magnBeat.sof != sof) || (magnBeat.eol != eol) || (magnBeat.eof != eof) ||
+            (angleBeat.sof != sof) || (angleBeat.eol != eol) || (angleBeat.eof != eof)) {
+          flagErr++;
+        }
+        int hw = magnBeat.data;
+        int alg = (int)*(magn_orig+cnt);
+        int diff = alg-hw;
+        int adiff = abs(diff);
+        magErr += (adiff != 0); // the magnitude matches the algorithm bit for bit
+        sumErr += adiff;
+        float angO = (double)*(angle_orig+cnt);
+        float angHw = angleBeat.data.to_double();
+        float angAdiff = abs(angO-angHw);
+        sumAngErr += angAdiff;
+        if (f == numFrames-1) {
+          out_hw[cnt] = hw;   // bit-accurate monochrome edge-detect output
+          garray[cnt] = alg;  // repurposing 'green' array to the original algorithmic edge-detect output
+        }
+        cnt++;
+      }
+    }
+
+    printf("Frame %d Magnitude: Manhattan norm per pixel %f\n",f,sumErr/(fH*fW));
+    printf("Frame %d Angle: Manhattan norm per pixel %f\n",f,sumAngErr/(fH*fW));
+  }
+  printf("Sideband flag mismatches: %d\n",flagErr);
+  printf("Magnitude mismatches against the algorithm: %d\n",magErr);
+
+  // Malformed input, the output is compared with a second design fed the
+  // well formed frames it should be resynchronized to
+  EdgeDetect ref;
+  ac_channel<EdgeDetect::pixelBeat>  ref_in;
+  ac_channel<EdgeDetect::magBeat>    refMagn;
+  ac_channel<EdgeDetect::angBeat>    refAngle;
+  int syncErr = 0;
+
+  // Lines longer than imageWidth are clamped
+  writeFrame(dat_in, rarray, iW, iW+8, 32);
+  writeFrame(ref_in, rarray, iW, iW, 32);
+  inst1.run(dat_in,magn,angle);
+  ref.run(ref_in,refMagn,refAngle);
+  syncErr += compareFrame(magn, angle, refMagn, refAngle, iW, 32, 32);
+
+  // Beats before the start of frame are dropped, a start of frame in the
+  // first line restarts the frame
+  EdgeDetect::pixelBeat junk;
+  junk.data = 0;
+  junk.sof = false;
+  junk.eol = true;
+  junk.eof = true;
+  dat_in.write(junk);
+  dat_in.write(junk);
+  writeFrame(dat_in, rarray, iW, 640, 32, 0, 50);
+  writeFrame(dat_in, rarray, iW, 640, 24);
+  writeFrame(ref_in, rarray, iW, 640, 24);
+  inst1.run(dat_in,magn,angle);
+  ref.run(ref_in,refMagn,refAngle);
+  syncErr += compareFrame(magn, angle, refMagn, refAngle, 640, 24, 24);
+
+  // A start of frame in line 20 ends the frame at line 19, whose bottom
+  // boundary is partly from line 20. The next frame follows unchanged
+  writeFrame(dat_in, rarray, iW, 640, 32, 20, 100);
+  writeFrame(dat_in, rarray, iW, 320, 16);
+  writeFrame(ref_in, rarray, iW, 640, 20);
+  writeFrame(ref_in, rarray, iW, 320, 16);
+  inst1.run(dat_in,magn,angle);
+  ref.run(ref_in,refMagn,refAngle);
+  syncErr += compareFrame(magn, angle, refMagn, refAngle, 640, 20, 19);
+  inst1.run(dat_in,magn,angle);
+  ref.run(ref_in,refMagn,refAngle);
+  syncErr += compareFrame(magn, angle, refMagn, refAngle, 320, 16, 16);
+  syncErr += dat_in.size(); // input left unread
+  printf("Resynchronization mismatches: %d\n",syncErr);
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, out_hw, out_hw, out_hw);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (rarray);
+  delete (out_hw);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  CCS_RETURN((flagErr || magErr || syncErr) ? -1 : 0);
+}
@@ -0,0 +1,238 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_GRADSTATS_H_
+#define _INCLUDED_EDGEDETECT_GRADSTATS_H_
+
+// Streaming gradient statistics stage, placed on the magnitude and angle
+// outputs of the edge detect designs. Both streams pass through unchanged
+// while a magnitude histogram, an orientation histogram, the number of
+// pixels at or above threshIn and the magnitude sum are accumulated. The
+// statistics are written on a side channel at the end of every frame.
+//
+// EdgeDetect_CircularBufGradStats computes the statistics inside the
+// circular buffer design, optionally without the pixel streams.
+
+#include <ac_fixed.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+#include "EdgeDetect_CircularBuf.h"
+#include <mc_scverify.h>
+
+// magBins     - magnitude histogram bins, a power of two from 2 to
+//               2^magT::width, each covers 2^magT::width/magBins magnitudes
+// angBins     - orientation histogram bins, evenly spaced over -pi to pi
+// passThrough - 1 to pass the magnitude and angle streams through, 0 to
+//               only write the statistics. The stream outputs are then
+//               never written
+// magT        - input magnitude type, 9-bit unsigned by default
+// angT        - input angle type, 3 integer and 5 fractional bits by default
+template <int imageWidth, int imageHeight, int magBins = 16, int angBins = 16, int passThrough = 1,
+          class magT = uint9, class angT = ac_fixed<8,3,true> >
+class EdgeDetect_GradStats
+{
+  // Define some bit-accurate types to use in this model
+  typedef magT                   magType;      // unsigned magnitute
+  typedef angT                   angType;      // quantized angle -pi to pi
+
+  static_assert((magBins & (magBins-1)) == 0 && magBins >= 2 && magBins <= (1 << magType::width), "magBins must be a power of two from 2 to 2^magT::width");
+  typedef ac_int<ac::nbits<magBins-1>::val,false> magIdx; // magnitude bin
+  typedef ac_int<ac::nbits<angBins-1>::val,false> angIdx; // orientation bin
+  typedef ac_fixed<ac::nbits<angBins>::val+6,ac::nbits<angBins>::val+2,true> angBinType; // scaled angle
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+  typedef magType threshType;
+  typedef ac_int<ac::nbits<imageWidth*imageHeight>::val,false> countType;       // pixels per frame
+  typedef ac_int<ac::nbits<((1LL << magType::width) - 1)*imageWidth*imageHeight>::val,false> magSumType; // magnitudes per frame
+
+  //--------------------------------------------------------------------------
+  // Struct: gradStats
+  //   Statistics of one frame
+  struct gradStats
+  {
+    countType  magHist[magBins]; // magnitude histogram
+    countType  angHist[angBins]; // orientation histogram
+    countType  edges;            // pixels at or above threshIn
+    magSumType magSum;           // magnitude sum, mean is magSum/(width*height)
+  };
+
+  EdgeDetect_GradStats() {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Passes the magnitude and angle
+  //   streams through, unless passThrough is 0, and writes the frame
+  //   statistics.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<magType>    &magn_in,
+                      ac_channel<angType>    &angle_in,
+                      maxW                   &widthIn,
+                      maxH                   &heightIn,
+                      threshType             &threshIn,
+                      ac_channel<magType>    &magn,
+                      ac_channel<angType>    &angle,
+                      ac_channel<gradStats>  &stats)
+  {
+    accumulate(magn_in, angle_in, widthIn, heightIn, threshIn, magn, angle, stats);
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: angleBin
+  //   Orientation histogram bin of an angle
+  static angIdx angleBin(angType at)
+  {
+    const ac_fixed<12,3,false> pi = 3.14159265358979;
+    const ac_fixed<ac::nbits<angBins>::val+12,ac::nbits<angBins>::val,false> scale = angBins / (2 * 3.14159265358979); // bins per radian
+    angBinType bin = (pi + at) * scale;
+    // The quantized angle can step just outside -pi to pi
+    if (bin < 0) {
+      return 0;
+    }
+    return (bin.to_int() >= angBins) ? angIdx(angBins-1) : angIdx(bin.to_int());
+  }
+
+protected:
+  //--------------------------------------------------------------------------
+  // Function: accumulate
+  //   Accumulate the statistics while passing the streams through
+#pragma hls_design
+  void accumulate(ac_channel<magType>   &magn_in,
+                  ac_channel<angType>   &angle_in,
+                  maxW                  &widthIn,
+                  maxH                  &heightIn,
+                  threshType            &threshIn,
+                  ac_channel<magType>   &magn,
+                  ac_channel<angType>   &angle,
+                  ac_channel<gradStats> &stats)
+  {
+    gradStats st;
+    magType   mag;
+    angType   at;
+
+#pragma hls_unroll yes
+    CLEAR_MAG: for (int i = 0; i < magBins; i++) {
+      st.magHist[i] = 0;
+    }
+#pragma hls_unroll yes
+    CLEAR_ANG: for (int i = 0; i < angBins; i++) {
+      st.angHist[i] = 0;
+    }
+    st.edges = 0;
+    st.magSum = 0;
+
+    SROW: for (maxH y = 0; ; y++) {
+      SCOL: for (maxW x = 0; ; x++) {
+        mag = magn_in.read(); // Read streaming interfaces
+        at = angle_in.read();
+        st.magHist[mag.template slc<magIdx::width>(magType::width - magIdx::width)]++;
+        st.angHist[angleBin(at)]++;
+        if (mag >= threshIn) {
+          st.edges++;
+        }
+        st.magSum += mag;
+        if (passThrough) {
+          magn.write(mag); // Write streaming interfaces
+          angle.write(at);
+        }
+        // programmable width exit condition
+        if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      //programmable height exit condition
+      if (y == maxH(heightIn-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+    stats.write(st); // end of frame
+  }
+
+};
+
+//----------------------------------------------------------------------------
+// Class: EdgeDetect_CircularBufGradStats
+//   EdgeDetect_CircularBuf with the frame statistics accumulated on chip.
+//   With passThrough the outputs are those of CircularBuf plus the
+//   statistics. Without it only the statistics leave the design, for a
+//   camera control loop that needs no pixels.
+template <int imageWidth, int imageHeight, int magBins = 16, int angBins = 16, int passThrough = 1,
+          class cfg = circularBufConfig>
+class EdgeDetect_CircularBufGradStats :
+  public EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg>,
+  public EdgeDetect_GradStats<imageWidth, imageHeight, magBins, angBins, passThrough,
+                              typename EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg>::magOutType,
+                              typename EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg>::angOutType>
+{
+  typedef EdgeDetect_CircularBuf<imageWidth, imageHeight, cfg> edgeBase;
+  typedef EdgeDetect_GradStats<imageWidth, imageHeight, magBins, angBins, passThrough,
+                               typename edgeBase::magOutType, typename edgeBase::angOutType> statsBase;
+  typedef typename edgeBase::pixelType pixelType;
+  typedef typename edgeBase::magType   magType;
+  typedef typename edgeBase::angType   angType;
+
+  static_assert(edgeBase::outputs == edgeBoth, "the histograms need both magnitude and angle");
+
+  // Static interconnect channels (FIFOs) between blocks
+  ac_channel<magType> mag; // magnitude into accumulate
+  ac_channel<angType> ang; // angle into accumulate
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef typename edgeBase::maxW       maxW;
+  typedef typename edgeBase::maxH       maxH;
+  typedef typename statsBase::threshType threshType;
+  typedef typename statsBase::gradStats  gradStats;
+  using statsBase::angleBin;
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. The EdgeDetect_CircularBuf
+  //   blocks followed by accumulate.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<pixelType>  &dat_in,
+                      maxW                   &widthIn,
+                      maxH                   &heightIn,
+                      threshType             &threshIn,
+                      ac_channel<magType>    &magn,
+                      ac_channel<angType>    &angle,
+                      ac_channel<gradStats>  &stats)
+  {
+    this->verticalDerivative(dat_in, widthIn, heightIn, this->dat, this->dy);
+    this->horizontalDerivative(this->dat, widthIn, heightIn, this->dx);
+    this->magnitudeAngle(this->dx, this->dy, widthIn, heightIn, mag, ang);
+    this->accumulate(mag, ang, widthIn, heightIn, threshIn, magn, angle, stats);
+  }
+};
+
+#endif
@@ -0,0 +1,245 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_CircularBuf.h"
+#include "EdgeDetect_GradStats.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <mc_scverify.h>
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  const int magBins = 16;
+  const int angBins = 8;
+  typedef EdgeDetect_GradStats<iW,iH,magBins,angBins> StatsT;
+  EdgeDetect_Algorithm             inst0;
+  EdgeDetect_CircularBuf<iW,iH>    inst1;
+  StatsT                           inst2;
+  // Fused designs, with and without the pixel streams
+  typedef EdgeDetect_CircularBufGradStats<iW,iH,magBins,angBins,1> FusedT;
+  typedef EdgeDetect_CircularBufGradStats<iW,iH,magBins,angBins,0> StatsOnlyT;
+  FusedT                           inst3;
+  StatsOnlyT                       inst4;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  EdgeDetect_CircularBuf<iW,iH>::maxW widthIn = iW;
+  EdgeDetect_CircularBuf<iW,iH>::maxH heightIn = iH;
+  StatsT::maxW statsWidthIn = iW;
+  StatsT::maxH statsHeightIn = iH;
+  StatsT::threshType threshIn = 60;
+  FusedT::maxW fusedWidthIn = iW;
+  FusedT::maxH fusedHeightIn = iH;
+  FusedT::threshType fusedThreshIn = 60;
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+  ac_channel<uint9>            magn_out;
+  ac_channel<ac_fixed<8,3> >   angle_out;
+  ac_channel<StatsT::gradStats> stats;
+  ac_channel<uint8>            fused_in, stats_only_in;
+  ac_channel<uint9>            fused_magn, stats_only_magn;
+  ac_channel<ac_fixed<8,3> >   fused_angle, stats_only_angle;
+  ac_channel<FusedT::gradStats> fused_stats;
+  ac_channel<StatsOnlyT::gradStats> stats_only_stats;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+  int *magn_hw = new int[iH*iW];
+  ac_fixed<8,3> *angle_hw = new ac_fixed<8,3>[iH*iW];
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      fused_in.write(rarray[cnt]);
+      stats_only_in.write(rarray[cnt]);
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1.run(dat_in,widthIn,heightIn,magn,angle);
+
+  // Capture the edge detect output and chain it through the statistics stage
+  ac_channel<uint9>            magn_stats;
+  ac_channel<ac_fixed<8,3> >   angle_stats;
+  for (int i = 0; i < iH*iW; i++) {
+    magn_hw[i] = magn.read();
+    angle_hw[i] = angle.read();
+    magn_stats.write(magn_hw[i]);
+    angle_stats.write(angle_hw[i]);
+  }
+  inst2.run(magn_stats,angle_stats,statsWidthIn,statsHeightIn,threshIn,magn_out,angle_out,stats);
+  inst3.run(fused_in,fusedWidthIn,fusedHeightIn,fusedThreshIn,fused_magn,fused_angle,fused_stats);
+  inst4.run(stats_only_in,fusedWidthIn,fusedHeightIn,fusedThreshIn,stats_only_magn,stats_only_angle,stats_only_stats);
+
+  // Host statistics of the bit-accurate outputs
+  unsigned long magHist[magBins] = { 0 };
+  unsigned long angHist[angBins] = { 0 };
+  unsigned long edges = 0;
+  unsigned long long magSum = 0;
+  unsigned long passErr = 0;
+  float sumErr = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    magHist[magn_hw[i] / (512/magBins)]++;
+    angHist[StatsT::angleBin(angle_hw[i]).to_int()]++;
+    edges += (magn_hw[i] >= threshIn.to_int());
+    magSum += magn_hw[i];
+    int hw = magn_out.read();
+    passErr += (hw != magn_hw[i]) || (angle_out.read() != angle_hw[i]);
+    passErr += (fused_magn.read() != magn_hw[i]) || (fused_angle.read() != angle_hw[i]);
+    sumErr += abs((int)magn_orig[i] - hw);
+    rarray[i] = hw;
+    garray[i] = (int)magn_orig[i];
+  }
+
+  StatsT::gradStats st = stats.read();
+  unsigned long statsErr = 0;
+  printf("Magnitude histogram:");
+  for (int i = 0; i < magBins; i++) {
+    printf(" %lu", (unsigned long)st.magHist[i].to_int64());
+    statsErr += (st.magHist[i].to_int64() != (long long)magHist[i]);
+  }
+  printf("\nOrientation histogram:");
+  for (int i = 0; i < angBins; i++) {
+    printf(" %lu", (unsigned long)st.angHist[i].to_int64());
+    statsErr += (st.angHist[i].to_int64() != (long long)angHist[i]);
+  }
+  printf("\n");
+  statsErr += (st.edges.to_int64() != (long long)edges);
+  statsErr += (st.magSum.to_int64() != (long long)magSum);
+
+  // Both fused designs must report the same statistics as the chained stage
+  FusedT::gradStats fusedSt = fused_stats.read();
+  StatsOnlyT::gradStats onlySt = stats_only_stats.read();
+  unsigned long fusedErr = 0;
+  for (int i = 0; i < magBins; i++) {
+    fusedErr += (fusedSt.magHist[i] != st.magHist[i]) || (onlySt.magHist[i] != st.magHist[i]);
+  }
+  for (int i = 0; i < angBins; i++) {
+    fusedErr += (fusedSt.angHist[i] != st.angHist[i]) || (onlySt.angHist[i] != st.angHist[i]);
+  }
+  fusedErr += (fusedSt.edges != st.edges) || (onlySt.edges != st.edges);
+  fusedErr += (fusedSt.magSum != st.magSum) || (onlySt.magSum != st.magSum);
+  // The statistics only design writes no pixels
+  fusedErr += stats_only_magn.size() + stats_only_angle.size();
+
+  printf("Magnitude: Manhattan norm per pixel %f\n",sumErr/(iH*iW));
+  printf("Edge density at threshold %d: %f\n", threshIn.to_int(), (double)st.edges.to_int64()/(iH*iW));
+  printf("Mean magnitude: %f\n", (double)st.magSum.to_int64()/(iH*iW));
+  printf("Statistics mismatches %lu, pass through mismatches %lu\n", statsErr, passErr);
+  printf("Fused design mismatches %lu\n", fusedErr);
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (magn_hw);
+  delete[] angle_hw;
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  if (statsErr || passErr || fusedErr) {
+    cout << "FAILED" << endl;
+    CCS_RETURN(1);
+  }
+  cout << "PASSED" << endl;
+  CCS_RETURN(0);
+}
@@ -0,0 +1,170 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_HOG_H_
+#define _INCLUDED_EDGEDETECT_HOG_H_
+
+// Streaming histogram of oriented gradients cell stage, chained after the
+// magnitude and angle outputs of the edge detect designs. Every pixel adds
+// its magnitude to one of numBins unsigned orientation bins (0 to pi) of its
+// cellSize x cellSize cell. One row of cell histograms is kept on chip, and
+// each cell histogram is written out when its last line completes, in
+// raster cell order. Cells at the right and bottom edges are partial when
+// the image size is not a multiple of cellSize.
+
+#include <ac_fixed.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+#include <mc_scverify.h>
+
+// cellSize - cell width and height in pixels, a power of two
+// numBins  - orientation bins over 0 to pi
+template <int imageWidth, int imageHeight, int cellSize = 8, int numBins = 9>
+class EdgeDetect_HOG
+{
+  static_assert((cellSize & (cellSize-1)) == 0 && cellSize >= 2, "cellSize must be a power of two");
+
+  // Define some bit-accurate types to use in this model
+  typedef uint9                  magType;      // 9-bit unsigned magnitute
+  typedef ac_fixed<8,3,true>     angType;      // 3 integer bit, 5 fractional bits for quantized angle -pi to pi
+  typedef ac_int<ac::nbits<numBins-1>::val,false> binIdx; // orientation bin
+  typedef ac_int<ac::nbits<cellSize-1>::val,false> cellPos; // pixel position in a cell
+  enum { cellsPerRow = (imageWidth + cellSize - 1) / cellSize };
+  typedef ac_int<ac::nbits<cellsPerRow-1>::val,false> cellIdx; // cell column
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+  typedef ac_int<ac::nbits<511*cellSize*cellSize>::val,false> accType; // magnitude sum of a cell
+
+  //--------------------------------------------------------------------------
+  // Struct: cellHist
+  //   Orientation histogram of one cell
+  struct cellHist
+  {
+    accType bin[numBins];
+  };
+
+  EdgeDetect_HOG() {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Accumulates the magnitude and
+  //   angle streams into cell histograms.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<magType>   &magn,
+                      ac_channel<angType>   &angle,
+                      maxW                  &widthIn,
+                      maxH                  &heightIn,
+                      ac_channel<cellHist>  &cells)
+  {
+    cellAccumulate(magn, angle, widthIn, heightIn, cells);
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: orientationBin
+  //   Unsigned orientation bin of an angle, angles below 0 fold onto 0 to pi
+  static binIdx orientationBin(angType at)
+  {
+    const ac_fixed<12,3,false> pi = 3.14159265358979;
+    const ac_fixed<ac::nbits<numBins>::val+12,ac::nbits<numBins>::val,false> scale = numBins / 3.14159265358979; // bins per radian
+    ac_fixed<10,4,true> a = (at < 0) ? ac_fixed<10,4,true>(at + pi) : ac_fixed<10,4,true>(at);
+    ac_fixed<ac::nbits<numBins>::val+6,ac::nbits<numBins>::val+2,true> bin = a * scale;
+    // The quantized angle can step just outside 0 to pi
+    if (bin < 0) {
+      return 0;
+    }
+    return (bin.to_int() >= numBins) ? binIdx(numBins-1) : binIdx(bin.to_int());
+  }
+
+private:
+  //--------------------------------------------------------------------------
+  // Function: cellAccumulate
+  //   Accumulate each cell in a register while its pixels on a line stream
+  //   in. The cell row buffer is read when a cell starts on a line and
+  //   written when it ends, so it sees one access per cellSize/2 pixels.
+#pragma hls_design
+  void cellAccumulate(ac_channel<magType>  &magn_in,
+                      ac_channel<angType>  &angle_in,
+                      maxW                 &widthIn,
+                      maxH                 &heightIn,
+                      ac_channel<cellHist> &cells)
+  {
+    // One row of cell histograms - Mapped to RAM
+    cellHist cell_buf[cellsPerRow];
+    cellHist cur;       // cell being accumulated
+    cellHist zero;
+    cellIdx  cx;
+    magType  mag;
+    binIdx   b;
+    bool     firstLine, lastLine, lastCol;
+
+#pragma hls_unroll yes
+    for (int i = 0; i < numBins; i++) {
+      zero.bin[i] = 0;
+    }
+
+    HROW: for (maxH y = 0; ; y++) {
+      firstLine = (y.template slc<cellPos::width>(0) == 0);
+      lastLine = (y.template slc<cellPos::width>(0) == cellSize-1) | (y == maxH(heightIn-1));
+      HCOL: for (maxW x = 0; ; x++) {
+        cx = x >> cellPos::width;
+        lastCol = (x.template slc<cellPos::width>(0) == cellSize-1) | (x == maxW(widthIn-1));
+        // Load the cell at its first pixel on the line, a new cell row starts from zero
+        if (x.template slc<cellPos::width>(0) == 0) {
+          cur = firstLine ? zero : cell_buf[cx];
+        }
+        mag = magn_in.read(); // Read streaming interfaces
+        b = orientationBin(angle_in.read());
+        cur.bin[b] += mag;
+        if (lastCol) {
+          if (lastLine) {
+            cells.write(cur); // Write streaming interface, cell complete
+          } else {
+            cell_buf[cx] = cur;
+          }
+        }
+        // programmable width exit condition
+        if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      //programmable height exit condition
+      if (y == maxH(heightIn-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+
+};
+
+#endif
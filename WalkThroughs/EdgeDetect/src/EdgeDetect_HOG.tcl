@@ -0,0 +1,35 @@
+#------------------------------------------------------------
+# Sliding Window Walkthrough - HOG cell accumulation
+#------------------------------------------------------------
+
+# Establish the location of this script and use it to reference all
+# other files in this example
+set sfd [file dirname [info script]]
+  
+# Reset the options to the factory defaults
+options defaults
+options set /Input/CppStandard c++11
+
+project new
+
+flow package require /SCVerify
+flow package option set /SCVerify/USE_CCS_BLOCK true
+flow package option set /SCVerify/INVOKE_ARGS "[file join $sfd image people_gray.bmp] out_algorithm.bmp out_hw.bmp"
+
+solution file add {$MGC_HOME/shared/include/bmpUtil/bmp_io.cpp} -type C++ -exclude true
+solution file add [file join $sfd EdgeDetect_HOG_tb.cpp] -type C++
+options set Output/OutputVHDL false
+
+go analyze
+directive set -DESIGN_HIERARCHY {{EdgeDetect_HOG<1296, 864, 8, 9>} {EdgeDetect_HOG<1296, 864, 8, 9>::cellAccumulate}}
+go compile
+solution library add nangate-45nm_beh -file {$MGC_HOME/pkgs/siflibs/nangate/nangate-45nm_beh.lib} -- -rtlsyntool OasysRTL
+
+go libraries
+directive set -CLOCKS {clk {-CLOCK_PERIOD 3.33 -CLOCK_EDGE rising -CLOCK_UNCERTAINTY 0.0 -CLOCK_HIGH_TIME 1.665 -RESET_SYNC_NAME rst -RESET_ASYNC_NAME arst_n -RESET_KIND sync -RESET_SYNC_ACTIVE high -RESET_ASYNC_ACTIVE low -ENABLE_ACTIVE high}}
+go assembly
+directive set /EdgeDetect_HOG<1296,864,8,9>/cellAccumulate/core/HROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_HOG<1296,864,8,9>/widthIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_HOG<1296,864,8,9>/heightIn:rsc -MAP_TO_MODULE {[DirectInput]}
+go architect
+go extract
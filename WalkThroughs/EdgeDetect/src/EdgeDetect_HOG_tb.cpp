@@ -0,0 +1,201 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_CircularBuf.h"
+#include "EdgeDetect_HOG.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <mc_scverify.h>
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  const int cellSize = 8;
+  const int numBins = 9;
+  const int cW = (iW + cellSize - 1) / cellSize;
+  const int cH = (iH + cellSize - 1) / cellSize;
+  typedef EdgeDetect_HOG<iW,iH,cellSize,numBins> HogT;
+  EdgeDetect_Algorithm             inst0;
+  EdgeDetect_CircularBuf<iW,iH>    inst1;
+  HogT                             inst2;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  EdgeDetect_CircularBuf<iW,iH>::maxW widthIn = iW;
+  EdgeDetect_CircularBuf<iW,iH>::maxH heightIn = iH;
+  HogT::maxW hogWidthIn = iW;
+  HogT::maxH hogHeightIn = iH;
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+  ac_channel<HogT::cellHist>   cells;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1.run(dat_in,widthIn,heightIn,magn,angle);
+
+  // Capture the edge detect output, accumulate the reference cell
+  // histograms and chain the output into the HOG stage
+  ac_channel<uint9>            magn_hog;
+  ac_channel<ac_fixed<8,3> >   angle_hog;
+  std::vector<long> ref(cW*cH*numBins, 0);
+  std::vector<double> alg(cW*cH*numBins, 0.0);
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      uint9 m = magn.read();
+      ac_fixed<8,3> a = angle.read();
+      int c = (y/cellSize)*cW + x/cellSize;
+      ref[c*numBins + HogT::orientationBin(a).to_int()] += m;
+      // Floating point reference of the algorithm output
+      double ang = angle_orig[y*iW+x] < 0 ? angle_orig[y*iW+x] + M_PI : angle_orig[y*iW+x];
+      int b = std::min((int)(ang * numBins / M_PI), numBins-1);
+      alg[c*numBins + b] += (int)magn_orig[y*iW+x];
+      magn_hog.write(m);
+      angle_hog.write(a);
+    }
+  }
+  inst2.run(magn_hog,angle_hog,hogWidthIn,hogHeightIn,cells);
+
+  unsigned long mismatches = 0;
+  unsigned long numCells = 0;
+  float sumErr = 0;
+  for (int c = 0; c < cW*cH; c++) {
+    HogT::cellHist h = cells.read();
+    int dominant = 0;
+    int algDominant = 0;
+    for (int b = 0; b < numBins; b++) {
+      mismatches += (h.bin[b].to_int() != ref[c*numBins+b]);
+      sumErr += fabs(alg[c*numBins+b] - h.bin[b].to_int());
+      dominant = (h.bin[b] > h.bin[dominant]) ? b : dominant;
+      algDominant = (alg[c*numBins+b] > alg[c*numBins+algDominant]) ? b : algDominant;
+    }
+    numCells++;
+    // Shade each cell by its dominant orientation
+    for (int y = (c/cW)*cellSize; y < std::min((c/cW+1)*cellSize, iH); y++) {
+      for (int x = (c%cW)*cellSize; x < std::min((c%cW+1)*cellSize, iW); x++) {
+        rarray[y*iW+x] = dominant * 255 / (numBins-1);
+        garray[y*iW+x] = algDominant * 255 / (numBins-1);
+      }
+    }
+  }
+  mismatches += cells.size(); // cells beyond the frame
+
+  printf("Cells %lu of %d, %d bins each\n", numCells, cW*cH, numBins);
+  printf("Cell bin mismatches against bit-accurate reference %lu\n", mismatches);
+  printf("Cell bins: Manhattan norm per bin against algorithm %f\n", sumErr/(cW*cH*numBins));
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  CCS_RETURN(0);
+}
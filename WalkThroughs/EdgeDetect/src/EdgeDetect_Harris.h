@@ -0,0 +1,270 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_HARRIS_H_
+#define _INCLUDED_EDGEDETECT_HARRIS_H_
+
+// Revision History
+//    Rev 1 - Coding of edge detection algorithm in C++
+//    Rev 2 - Converted to using bit-accurate data types
+//            Calculated bit growth for internal variables
+//            Quantized angle values for 5 fractional bits -pi to pi
+//    Rev 3 - Switch to using HLSLIBS ac_math library for high performance
+//            math functions.
+//            Add support for verification using SCVerify
+//    Rev 4 - Refinining memory architecture for 1PPC
+//    Rev 5 - Modularized into hierarchy for performance
+//    Rev 6 - Recode to use single-port memories
+//    Rev 7 - Recode to make the design programmable for image size
+//    Rev 8 - Recode to use single-port memories in circular fashion
+//    Rev 9 - Recode both derivatives on a generic KxK sliding window
+//    Rev 10 - Add a Harris corner response computed from the dx/dy streams
+
+#include <ac_fixed.h>
+//This is Catapult's math library implementation, see docs for details
+#include <ac_math/ac_sqrt_pwl.h>
+#include <ac_math/ac_atan2_cordic.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+
+// Include constant kernel definition
+#include "edge_defs.h"
+// Include line buffer manager
+#include "sliding_window.h"
+#include <mc_scverify.h>
+
+template <int imageWidth, int imageHeight>
+class EdgeDetect_Harris
+{
+  // Define some bit-accurate types to use in this model
+  typedef uint8                  pixelType;    // input pixel is 0-255
+  enum {
+    winSize = 3,                               // 3x3 window for the 3-tap kernel and the box filter
+    gradW   = edgeKernel::gradBits(8),         // -255 to 255
+    magW    = edgeKernel::magBits(8),          // 0 to 360
+    boxW    = 2*gradW + 3,                     // box sum of 9 products, -9*255^2 to 9*255^2
+    respW   = 2*boxW + 1                       // trace^2 exceeds det, plus sign
+  };
+  typedef ac_int<gradW,true>     gradType;     // Derivative range derived from the kernel coefficients
+  typedef ac_int<2*gradW,false>  sqType;       // Result of gradType x gradType
+  typedef ac_fixed<2*gradW+1,2*gradW+1,false> sumType; // Result of sqType + sqType fixed pt integer for squareroot
+  typedef ac_int<magW,false>     magType;      // unsigned magnitute result
+  typedef ac_fixed<8,3,true>     angType;      // 3 integer bit, 5 fractional bits for quantized angle -pi to pi
+  typedef ac_int<2*gradW-1,true> prodType;     // dx*dy, -255^2 to 255^2
+  typedef ac_int<boxW,true>      boxType;      // box filtered tensor element
+  typedef ac_int<respW,true>     respType;     // corner response
+
+  // Static interconnect channels (FIFOs) between blocks
+  ac_channel<gradType>       dy;
+  ac_channel<gradType>       dx;
+  ac_channel<gradType>       dy_t; // derivative taps for the corner response
+  ac_channel<gradType>       dx_t;
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+winSize/2>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+winSize/2>::val,false> maxH;
+  typedef respType cornerType;
+  EdgeDetect_Harris() {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Combines the window derivatives,
+  //   magnitude/angle computation and the corner response.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<pixelType>  &dat_in,
+                      maxW                   &widthIn,
+                      maxH                   &heightIn,
+                      ac_channel<magType>    &magn,
+                      ac_channel<angType>    &angle,
+                      ac_channel<cornerType> &corner)
+  {
+    windowDerivative(dat_in, widthIn, heightIn, dx, dy, dx_t, dy_t);
+    magnitudeAngle(dx, dy, widthIn, heightIn, magn, angle);
+    cornerResponse(dx_t, dy_t, widthIn, heightIn, corner);
+  }
+
+private:
+  //--------------------------------------------------------------------------
+  // Function: windowDerivative
+  //   Compute the horizontal and vertical derivatives on the center row and
+  //   column of a 3x3 window of the input data
+#pragma hls_design
+  void windowDerivative(ac_channel<pixelType> &dat_in,
+                        maxW                  &widthIn,
+                        maxH                  &heightIn,
+                        ac_channel<gradType>  &dx,
+                        ac_channel<gradType>  &dy,
+                        ac_channel<gradType>  &dx_t,
+                        ac_channel<gradType>  &dy_t)
+  {
+    // Line buffers and window registers
+    SlidingWindow<pixelType,winSize,imageWidth> win;
+    pixelType pix;
+    gradType  gx, gy;
+
+    // Remove loop upperbounds for RTL code coverage
+    // Use bit accurate data types on loop iterator
+    WROW: for (maxH y = 0; ; y++) { // One extra iteration to ramp-up window
+      WCOL: for (maxW x = 0; ; x++) {
+        pix = 0;
+        if ((y < heightIn) & (x < widthIn)) {
+          pix = dat_in.read(); // Read streaming interface
+        }
+        win.shift(pix, x, y, widthIn, heightIn);
+
+        if (win.valid(x, y)) { // Write streaming interfaces
+          // Calculate derivatives
+          gx = edgeKernel::apply(win.window[1][0], win.window[1][1], win.window[1][2]);
+          gy = edgeKernel::apply(win.window[0][1], win.window[1][1], win.window[2][1]);
+          dx.write(gx);
+          dy.write(gy);
+          dx_t.write(gx);
+          dy_t.write(gy);
+        }
+        // programmable width exit condition, ramp-up column included
+        if (x == widthIn)
+          break;
+      }
+      // programmable height exit condition, ramp-up line included
+      if (y == heightIn)
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: magnitudeAngle
+  //   Compute the magnitute and angle based on the horizontal and vertical
+  //   derivative results
+#pragma hls_design
+  void magnitudeAngle(ac_channel<gradType> &dx_in,
+                      ac_channel<gradType> &dy_in,
+                      maxW                 &widthIn,
+                      maxH                 &heightIn,
+                      ac_channel<magType>  &magn,
+                      ac_channel<angType>  &angle)
+  {
+    gradType dx, dy;
+    sqType dx_sq;
+    sqType dy_sq;
+    sumType sum; // fixed point integer for sqrt
+    angType at;
+    ac_fixed<magW+7,magW,false> sq_rt; // square-root return type
+
+    MROW: for (maxH y = 0; ; y++) {
+      MCOL: for (maxW x = 0; ; x++) {
+        dx = dx_in.read();
+        dy = dy_in.read();
+        dx_sq = dx * dx;
+        dy_sq = dy * dy;
+        sum = dx_sq + dy_sq;
+        // Catapult's math library piecewise linear implementation of sqrt and atan2
+        ac_math::ac_sqrt_pwl(sum,sq_rt);
+        magn.write(sq_rt.to_uint());
+        ac_math::ac_atan2_cordic((ac_fixed<gradW,gradW>)dy, (ac_fixed<gradW,gradW>)dx, at);
+        angle.write(at);
+        // programmable width exit condition
+        if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      //programmable height exit condition
+      if (y == maxH(heightIn-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: cornerResponse
+  //   Form the structure tensor products, box filter them over a 3x3 window
+  //   with replicated borders and compute the Harris response
+  //   det - k*trace^2, with k = 5/128 (about 0.04)
+#pragma hls_design
+  void cornerResponse(ac_channel<gradType>   &dx_in,
+                      ac_channel<gradType>   &dy_in,
+                      maxW                   &widthIn,
+                      maxH                   &heightIn,
+                      ac_channel<cornerType> &corner)
+  {
+    // Line buffers and window registers for each tensor product
+    SlidingWindow<prodType,winSize,imageWidth> winXX, winYY, winXY;
+    prodType   pxx, pyy, pxy;
+    gradType   gx, gy;
+    boxType    sxx, syy, sxy;
+    respType   det, tr2;
+
+    CROW: for (maxH y = 0; ; y++) { // One extra iteration to ramp-up window
+      CCOL: for (maxW x = 0; ; x++) {
+        pxx = 0;
+        pyy = 0;
+        pxy = 0;
+        if ((y < heightIn) & (x < widthIn)) {
+          gx = dx_in.read(); // Read streaming interfaces
+          gy = dy_in.read();
+          pxx = gx * gx;
+          pyy = gy * gy;
+          pxy = gx * gy;
+        }
+        winXX.shift(pxx, x, y, widthIn, heightIn);
+        winYY.shift(pyy, x, y, widthIn, heightIn);
+        winXY.shift(pxy, x, y, widthIn, heightIn);
+
+        if (winXX.valid(x, y)) {
+          sxx = 0;
+          syy = 0;
+          sxy = 0;
+#pragma hls_unroll yes
+          for (int r = 0; r < winSize; r++) {
+#pragma hls_unroll yes
+            for (int c = 0; c < winSize; c++) {
+              sxx += winXX.window[r][c];
+              syy += winYY.window[r][c];
+              sxy += winXY.window[r][c];
+            }
+          }
+          det = sxx * syy - sxy * sxy;
+          tr2 = (sxx + syy) * (sxx + syy);
+          corner.write(det - ((tr2 * 5) >> 7)); // Write streaming interface
+        }
+        // programmable width exit condition, ramp-up column included
+        if (x == widthIn)
+          break;
+      }
+      // programmable height exit condition, ramp-up line included
+      if (y == heightIn)
+        break;
+    }
+  }
+
+};
+
+#endif
@@ -0,0 +1,207 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_Harris.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <mc_scverify.h>
+
+// Host reference for the corner response, derivatives and box filter with
+// replicated borders
+static void harrisRef(const unsigned char *img, int w, int h, long long *resp)
+{
+  std::vector<long long> xx(w*h), yy(w*h), xy(w*h);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      int gx = img[y*w + std::max(x-1, 0)] - img[y*w + std::min(x+1, w-1)];
+      int gy = img[std::max(y-1, 0)*w + x] - img[std::min(y+1, h-1)*w + x];
+      xx[y*w+x] = gx*gx;
+      yy[y*w+x] = gy*gy;
+      xy[y*w+x] = gx*gy;
+    }
+  }
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      long long sxx = 0, syy = 0, sxy = 0;
+      for (int r = -1; r <= 1; r++) {
+        for (int c = -1; c <= 1; c++) {
+          int i = std::min(std::max(y+r, 0), h-1)*w + std::min(std::max(x+c, 0), w-1);
+          sxx += xx[i];
+          syy += yy[i];
+          sxy += xy[i];
+        }
+      }
+      resp[y*w+x] = sxx*syy - sxy*sxy - (((sxx+syy)*(sxx+syy)*5) >> 7);
+    }
+  }
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  EdgeDetect_Algorithm        inst0;
+  EdgeDetect_Harris<iW,iH>    inst1;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  EdgeDetect_Harris<iW,iH>::maxW widthIn = iW;
+  EdgeDetect_Harris<iW,iH>::maxH heightIn = iH;
+  const long long cornerThresh = 1000000000LL; // corner response threshold for reporting
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+  ac_channel<EdgeDetect_Harris<iW,iH>::cornerType> corner;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+  long long *corner_ref = new long long[iH*iW];
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1.run(dat_in,widthIn,heightIn,magn,angle,corner);
+  harrisRef(dat_in_orig, iW, iH, corner_ref);
+
+  cnt = 0;
+  float sumErr = 0;
+  float sumAngErr = 0;
+  unsigned long cornerErr = 0;
+  unsigned long corners = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      int hw = magn.read();
+      int alg = (int)*(magn_orig+cnt);
+      int diff = alg-hw;
+      int adiff = abs(diff);
+      sumErr += adiff;
+      float angO = (double)*(angle_orig+cnt);
+      float angHw = angle.read().to_double();
+      float angAdiff = abs(angO-angHw);
+      sumAngErr += angAdiff;
+      long long r = corner.read().to_int64();
+      cornerErr += (r != corner_ref[cnt]);
+      corners += (r > cornerThresh);
+      rarray[cnt] = (r > cornerThresh) ? 255 : hw/2; // corners over the bit-accurate edges
+      garray[cnt] = alg;  // original algorithmic edge-detect output
+      cnt++;
+    }
+  }
+
+  printf("Magnitude: Manhattan norm per pixel %f\n",sumErr/(iH*iW));
+  printf("Angle: Manhattan norm per pixel %f\n",sumAngErr/(iH*iW));
+  printf("Corner response mismatches %lu\n", cornerErr);
+  printf("Corner pixels above %lld: %lu\n", cornerThresh, corners);
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (corner_ref);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  CCS_RETURN(0);
+}
@@ -0,0 +1,318 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_HOUGH_H_
+#define _INCLUDED_EDGEDETECT_HOUGH_H_
+
+// Streaming Hough line voting stage, chained after the magnitude and angle
+// outputs of the edge detect designs. Every pixel at or above threshIn votes
+// for the lines x*cos(theta) + y*sin(theta) = rho through it, but only for
+// the 2*band+1 theta bins around its gradient direction instead of all of
+// them. The accumulator is kept on chip, split into thetaBanks memories by
+// theta bin so the votes of one pixel never share a memory. It is ping-ponged:
+// a frame is voted into one accumulator while the other is read out (and
+// cleared) theta major, so each call outputs the votes of the previous frame
+// and the input never stalls for the readout. RAM contents are not reset, so
+// the first frame after reset clears both accumulators before voting and
+// outputs an empty accumulator.
+// Each memory is read and written back every cycle at II=1. The counts
+// written in the last ramLatency+1 cycles are held in bypass registers, so
+// votes for a cell still in flight to the RAM count too.
+
+#include <ac_fixed.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+
+// Include bit growth helpers
+#include "edge_defs.h"
+#include <mc_scverify.h>
+
+// rhoShift - rho bin size is 2^rhoShift pixels
+// band     - theta bins voted on each side of the gradient direction
+template <int imageWidth, int imageHeight, int rhoShift = 2, int band = 2>
+class EdgeDetect_Hough
+{
+public:
+  enum {
+    thetaBins = 64,                                                     // theta bins over 0 to pi
+    thetaBanks = 8,                                                     // accumulator memories
+    rhoMax    = (int)edgeSqrt((long long)imageWidth*imageWidth + (long long)imageHeight*imageHeight) + 1, // |rho| bound
+    rhoHalf   = (rhoMax >> rhoShift) + 1,
+    rhoBins   = 2*rhoHalf + 1                                           // rho bins over -rhoMax to rhoMax
+  };
+
+private:
+  static_assert(2*band+1 <= thetaBanks, "band votes must fit in separate accumulator memories");
+
+  // Define some bit-accurate types to use in this model
+  typedef uint9                  magType;      // 9-bit unsigned magnitute
+  typedef ac_fixed<8,3,true>     angType;      // 3 integer bit, 5 fractional bits for quantized angle -pi to pi
+  typedef ac_fixed<16,2,true>    trigType;     // cos/sin table entry
+  typedef ac_fixed<ac::nbits<rhoMax>::val+9,ac::nbits<rhoMax>::val+2,true> rhoType; // signed rho
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+  typedef magType threshType;
+  typedef ac_int<ac::nbits<thetaBins-1>::val,false> thetaIdx;  // theta bin
+  typedef ac_int<ac::nbits<rhoBins-1>::val,false> rhoIdx;      // rho bin
+  typedef ac_int<16,false>       voteType;     // votes per cell, saturating
+
+  EdgeDetect_Hough():pp(false),cleared(false) {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Votes the frame into the
+  //   accumulator and reads out the accumulator of the previous frame.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<magType>   &magn,
+                      ac_channel<angType>   &angle,
+                      maxW                  &widthIn,
+                      maxH                  &heightIn,
+                      threshType            &threshIn,
+                      ac_channel<voteType>  &votes)
+  {
+    vote(magn, angle, widthIn, heightIn, threshIn, votes);
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: thetaBin
+  //   Theta bin of the line normal for a gradient angle. The normal is the
+  //   gradient direction folded onto 0 to pi.
+  static thetaIdx thetaBin(angType at)
+  {
+    const ac_fixed<12,3,false> pi = 3.14159265358979;
+    const ac_fixed<16,5,false> scale = thetaBins / 3.14159265358979; // bins per radian
+    ac_fixed<10,4,true> a = (at < 0) ? ac_fixed<10,4,true>(at + pi) : ac_fixed<10,4,true>(at);
+    ac_fixed<12,8,true,AC_RND> bin = a * scale; // round to the nearest bin
+    return thetaIdx(bin.to_int() & (thetaBins-1));
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: rhoBin
+  //   Rho bin of the line through (x,y) with normal theta bin t
+  static rhoIdx rhoBin(maxW x, maxH y, thetaIdx t)
+  {
+    // cos(pi*t/64) for t = 0 to 32
+    static const trigType cosTab[thetaBins/2+1] = {
+      1.000000000, 0.998795456, 0.995184727, 0.989176510, 0.980785280, 0.970031253,
+      0.956940336, 0.941544065, 0.923879533, 0.903989293, 0.881921264, 0.857728610,
+      0.831469612, 0.803207531, 0.773010453, 0.740951125, 0.707106781, 0.671558955,
+      0.634393284, 0.595699304, 0.555570233, 0.514102744, 0.471396737, 0.427555093,
+      0.382683432, 0.336889853, 0.290284677, 0.242980180, 0.195090322, 0.146730474,
+      0.098017140, 0.049067674, 0.000000000
+    };
+    trigType c = (t <= thetaBins/2) ? cosTab[t] : trigType(-cosTab[thetaBins - t]);
+    trigType s = (t >= thetaBins/2) ? cosTab[t - thetaBins/2] : cosTab[thetaBins/2 - t];
+    rhoType rho = x * c + y * s;
+    // Shift to the rho bin, offset so rho = 0 is the center bin
+    return rhoIdx((rho.to_int() >> rhoShift) + rhoHalf);
+  }
+
+private:
+  enum {
+    ramLatency  = 1,             // read latency of the accumulator RAM, ccs_ram_sync_1R1W
+    bypassDepth = ramLatency + 1 // writes that may not have reached the RAM yet
+  };
+  typedef ac_int<ac::nbits<thetaBanks-1>::val,false> bankIdx;                      // accumulator memory
+  typedef ac_int<ac::nbits<(thetaBins/thetaBanks)*rhoBins-1>::val,false> bankAddr; // cell within a memory
+
+  // Ping-pong accumulators, theta bin t lives in memory t%thetaBanks - Mapped to RAM
+  voteType acc0[thetaBanks][thetaBins/thetaBanks][rhoBins];
+  voteType acc1[thetaBanks][thetaBins/thetaBanks][rhoBins];
+  bool     pp;      // flag for rotating the accumulators, acc1 is voted when set
+  bool     cleared; // accumulators cleared since reset
+
+  //--------------------------------------------------------------------------
+  // Function: readOut
+  //   Read out and clear one cell of the accumulator voted in the previous
+  //   frame, theta major
+  void readOut(thetaIdx &ot, rhoIdx &orho, bool &outDone, ac_channel<voteType> &votes)
+  {
+    if (pp) {
+      votes.write(acc0[ot%thetaBanks][ot/thetaBanks][orho]); // Write streaming interface
+      acc0[ot%thetaBanks][ot/thetaBanks][orho] = 0;
+    } else {
+      votes.write(acc1[ot%thetaBanks][ot/thetaBanks][orho]); // Write streaming interface
+      acc1[ot%thetaBanks][ot/thetaBanks][orho] = 0;
+    }
+    outDone = (ot == thetaBins-1) & (orho == rhoBins-1);
+    if (orho == rhoBins-1) {
+      orho = 0;
+      ot++;
+    } else {
+      orho++;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: vote
+  //   Accumulate the votes of one frame into one accumulator while the
+  //   other, holding the votes of the previous frame, is read out and
+  //   cleared one cell per pixel. The readout only runs past the end of
+  //   the frame for frames with fewer pixels than cells. Both accumulators
+  //   are cleared first on the first frame.
+#pragma hls_design
+  void vote(ac_channel<magType>  &magn_in,
+            ac_channel<angType>  &angle_in,
+            maxW                 &widthIn,
+            maxH                 &heightIn,
+            threshType           &threshIn,
+            ac_channel<voteType> &votes)
+  {
+    magType  mag;
+    angType  at;
+    thetaIdx t, tb;
+    rhoIdx   r;
+    bankIdx  b;
+    bankAddr a;
+    voteType cnt;
+    bool     hit;
+    // Bypass registers, the cells and counts written to each memory in the
+    // last bypassDepth cycles, newest first
+    bankAddr bypAddr[thetaBanks][bypassDepth];
+    voteType bypVote[thetaBanks][bypassDepth];
+    bool     bypValid[thetaBanks][bypassDepth];
+    // Writes of this cycle
+    bankAddr wrAddr[thetaBanks];
+    voteType wrVote[thetaBanks];
+    bool     wrValid[thetaBanks];
+    // Readout position in the previous frame accumulator
+    thetaIdx ot = 0;
+    rhoIdx   orho = 0;
+    bool     outDone = false;
+
+    // RAM is not reset, clear it once before the first frame. The first
+    // readout is an empty accumulator.
+    if (!cleared) {
+      CTHETA: for (int i = 0; i < thetaBins/thetaBanks; i++) {
+        CRHO: for (int j = 0; j < rhoBins; j++) {
+#pragma hls_unroll yes
+          CBANK: for (int k = 0; k < thetaBanks; k++) {
+            acc0[k][i][j] = 0;
+            acc1[k][i][j] = 0;
+          }
+        }
+      }
+      cleared = true;
+    }
+
+#pragma hls_unroll yes
+    BYP: for (int k = 0; k < thetaBanks; k++) {
+#pragma hls_unroll yes
+      for (int d = 0; d < bypassDepth; d++) {
+        bypValid[k][d] = false;
+      }
+    }
+
+    VROW: for (maxH y = 0; ; y++) {
+      VCOL: for (maxW x = 0; ; x++) {
+        mag = magn_in.read(); // Read streaming interfaces
+        at = angle_in.read();
+#pragma hls_unroll yes
+        for (int k = 0; k < thetaBanks; k++) {
+          wrValid[k] = false;
+        }
+        if (mag >= threshIn) {
+          t = thetaBin(at);
+          // Vote in the theta band around the gradient direction, wrapping at pi
+#pragma hls_unroll yes
+          for (int k = -band; k <= band; k++) {
+            tb = t + k; // wraps modulo thetaBins
+            r = rhoBin(x, y, tb);
+            b = tb % thetaBanks;
+            a = (tb / thetaBanks) * rhoBins + r;
+            // A write back of the last bypassDepth cycles may not have
+            // reached the memory yet, take the newest count from the bypass
+            // registers instead
+            hit = false;
+#pragma hls_unroll yes
+            for (int d = 0; d < bypassDepth; d++) {
+              if (!hit & bypValid[b][d] & (bypAddr[b][d] == a)) {
+                cnt = bypVote[b][d];
+                hit = true;
+              }
+            }
+            if (!hit) {
+              cnt = pp ? acc1[b][tb/thetaBanks][r] : acc0[b][tb/thetaBanks][r];
+            }
+            if (cnt != voteType(-1)) {
+              cnt++;
+            }
+            if (pp) {
+              acc1[b][tb/thetaBanks][r] = cnt;
+            } else {
+              acc0[b][tb/thetaBanks][r] = cnt;
+            }
+            wrAddr[b] = a;
+            wrVote[b] = cnt;
+            wrValid[b] = true;
+          }
+        }
+        // Age the bypass registers by one cycle
+#pragma hls_unroll yes
+        for (int k = 0; k < thetaBanks; k++) {
+#pragma hls_unroll yes
+          for (int d = bypassDepth-1; d > 0; d--) {
+            bypAddr[k][d] = bypAddr[k][d-1];
+            bypVote[k][d] = bypVote[k][d-1];
+            bypValid[k][d] = bypValid[k][d-1];
+          }
+          bypAddr[k][0] = wrAddr[k];
+          bypVote[k][0] = wrVote[k];
+          bypValid[k][0] = wrValid[k];
+        }
+        // Read out the previous frame alongside
+        if (!outDone) {
+          readOut(ot, orho, outDone, votes);
+        }
+        // programmable width exit condition
+        if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      //programmable height exit condition
+      if (y == maxH(heightIn-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+
+    // Finish the readout of frames smaller than the accumulator
+    OTAIL: while (!outDone) {
+      readOut(ot, orho, outDone, votes);
+    }
+    pp = !pp;
+  }
+
+};
+
+#endif
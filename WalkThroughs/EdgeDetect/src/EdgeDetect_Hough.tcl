@@ -0,0 +1,44 @@
+#------------------------------------------------------------
+# Sliding Window Walkthrough - Hough line accumulator
+#------------------------------------------------------------
+
+# Establish the location of this script and use it to reference all
+# other files in this example
+set sfd [file dirname [info script]]
+  
+# Reset the options to the factory defaults
+options defaults
+options set /Input/CppStandard c++11
+
+project new
+
+flow package require /SCVerify
+flow package option set /SCVerify/USE_CCS_BLOCK true
+flow package option set /SCVerify/INVOKE_ARGS "[file join $sfd image people_gray.bmp] out_algorithm.bmp out_hw.bmp"
+
+solution file add {$MGC_HOME/shared/include/bmpUtil/bmp_io.cpp} -type C++ -exclude true
+solution file add [file join $sfd EdgeDetect_Hough_tb.cpp] -type C++
+options set Output/OutputVHDL false
+
+go analyze
+directive set -DESIGN_HIERARCHY {{EdgeDetect_Hough<1296, 864, 2, 2>} {EdgeDetect_Hough<1296, 864, 2, 2>::vote}}
+go compile
+solution library add nangate-45nm_beh -file {$MGC_HOME/pkgs/siflibs/nangate/nangate-45nm_beh.lib} -- -rtlsyntool OasysRTL
+solution library add ccs_sample_mem -file {$MGC_HOME/pkgs/siflibs/ccs_sample_mem.lib}
+
+go libraries
+directive set -CLOCKS {clk {-CLOCK_PERIOD 3.33 -CLOCK_EDGE rising -CLOCK_UNCERTAINTY 0.0 -CLOCK_HIGH_TIME 1.665 -RESET_SYNC_NAME rst -RESET_ASYNC_NAME arst_n -RESET_KIND sync -RESET_SYNC_ACTIVE high -RESET_ASYNC_ACTIVE low -ENABLE_ACTIVE high}}
+go assembly
+directive set /EdgeDetect_Hough<1296,864,2,2>/vote/core/CTHETA -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_Hough<1296,864,2,2>/vote/core/VROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_Hough<1296,864,2,2>/vote/core/OTAIL -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_Hough<1296,864,2,2>/widthIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_Hough<1296,864,2,2>/heightIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_Hough<1296,864,2,2>/threshIn:rsc -MAP_TO_MODULE {[DirectInput]}
+# ramLatency in EdgeDetect_Hough.h matches the one cycle read latency of ccs_ram_sync_1R1W
+directive set /EdgeDetect_Hough<1296,864,2,2>/vote/acc0:rsc -BLOCK_SIZE 6248
+directive set /EdgeDetect_Hough<1296,864,2,2>/vote/acc0:rsc -MAP_TO_MODULE ccs_sample_mem.ccs_ram_sync_1R1W
+directive set /EdgeDetect_Hough<1296,864,2,2>/vote/acc1:rsc -BLOCK_SIZE 6248
+directive set /EdgeDetect_Hough<1296,864,2,2>/vote/acc1:rsc -MAP_TO_MODULE ccs_sample_mem.ccs_ram_sync_1R1W
+go architect
+go extract
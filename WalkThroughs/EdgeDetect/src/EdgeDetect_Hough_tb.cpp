@@ -0,0 +1,268 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_CircularBuf.h"
+#include "EdgeDetect_Hough.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <mc_scverify.h>
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  const int rhoShift = 2;
+  const int band = 2;
+  typedef EdgeDetect_Hough<iW,iH,rhoShift,band> HoughT;
+  const int tBins = HoughT::thetaBins;
+  const int rBins = HoughT::rhoBins;
+  EdgeDetect_Algorithm             inst0;
+  EdgeDetect_CircularBuf<iW,iH>    inst1;
+  // Build the Hough stage over memory holding a nonzero pattern, as the
+  // accumulator RAM comes out of power up
+  unsigned char *mem = new unsigned char[sizeof(HoughT)];
+  memset(mem, 0x01, sizeof(HoughT));
+  HoughT                          *inst2 = new (mem) HoughT;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  EdgeDetect_CircularBuf<iW,iH>::maxW widthIn = iW;
+  EdgeDetect_CircularBuf<iW,iH>::maxH heightIn = iH;
+  HoughT::maxW houghWidthIn = iW;
+  HoughT::maxH houghHeightIn = iH;
+  HoughT::threshType threshIn = 64;
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+  ac_channel<HoughT::voteType> votes;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1.run(dat_in,widthIn,heightIn,magn,angle);
+
+  // Capture the edge detect output
+  std::vector<uint9> magnHw(iH*iW);
+  std::vector<ac_fixed<8,3> > angleHw(iH*iW);
+  for (int i = 0; i < iH*iW; i++) {
+    magnHw[i] = magn.read();
+    angleHw[i] = angle.read();
+  }
+
+  // Vote three frames. Each call outputs the accumulator of the previous
+  // frame, the first call the empty accumulator cleared over the power up
+  // contents. The second frame is mirrored left to right, the third is a
+  // small frame without edges that flushes out the second and finishes its
+  // readout after the frame.
+  const int numFrames = 3;
+  const int frameW[numFrames] = {iW, iW, 64};
+  const int frameH[numFrames] = {iH, iH, 32};
+  unsigned long mismatches = 0;
+  unsigned long edgePixels = 0;
+  unsigned long totalVotes = 0;
+  std::vector<long> acc(tBins*rBins);
+  std::vector<long> ref(tBins*rBins, 0);      // votes of the previous frame
+  for (int frame = 0; frame < numFrames; frame++) {
+    // Vote the reference accumulator and chain the frame into the Hough stage
+    ac_channel<uint9>            magn_hough;
+    ac_channel<ac_fixed<8,3> >   angle_hough;
+    std::vector<long> frameRef(tBins*rBins, 0);
+    unsigned long frameEdges = 0;
+    for (int y = 0; y < frameH[frame]; y++) {
+      for (int x = 0; x < frameW[frame]; x++) {
+        int i = (frame == 1) ? (y*iW + iW-1-x) : (y*iW + x);
+        uint9 m = (frame == 2) ? uint9(0) : magnHw[i];
+        ac_fixed<8,3> a = angleHw[i];
+        if (m >= threshIn) {
+          int t = HoughT::thetaBin(a).to_int();
+          for (int k = -band; k <= band; k++) {
+            int tb = (t + k + tBins) % tBins;
+            long &v = frameRef[tb*rBins + HoughT::rhoBin(x, y, tb).to_int()];
+            v = std::min(v + 1, 65535L);
+          }
+          frameEdges++;
+        }
+        if (frame == 0) {
+          garray[y*iW+x] = (m >= threshIn) ? 255 : 0;
+        }
+        magn_hough.write(m);
+        angle_hough.write(a);
+      }
+    }
+    houghWidthIn = frameW[frame];
+    houghHeightIn = frameH[frame];
+    inst2->run(magn_hough,angle_hough,houghWidthIn,houghHeightIn,threshIn,votes);
+
+    unsigned long frameMismatches = 0;
+    unsigned long frameVotes = 0;
+    std::vector<long> out(tBins*rBins);
+    for (int i = 0; i < tBins*rBins; i++) {
+      out[i] = votes.read().to_int();
+      frameMismatches += (out[i] != ref[i]);
+      frameVotes += out[i];
+    }
+    frameMismatches += votes.size(); // votes beyond the accumulator
+    printf("Frame %d: accumulator of the previous frame, %lu votes, mismatches against bit-accurate reference %lu\n",
+           frame, frameVotes, frameMismatches);
+    mismatches += frameMismatches;
+    if (frame == 0) {
+      edgePixels = frameEdges;
+    }
+    if (frame == 1) { // votes of the first frame
+      acc = out;
+      totalVotes = frameVotes;
+    }
+    ref = frameRef;
+  }
+
+  printf("Edge pixels %lu, votes %lu, %.1f votes per edge pixel instead of %d\n",
+         edgePixels, totalVotes, edgePixels ? (double)totalVotes/edgePixels : 0.0, tBins);
+
+  // Report and draw the strongest lines
+  memset(rarray, 0, iH*iW);
+  for (int n = 0; n < 5; n++) {
+    int best = std::max_element(acc.begin(), acc.end()) - acc.begin();
+    int t = best / rBins;
+    int rho = ((best % rBins) - HoughT::rhoHalf) << rhoShift;
+    double th = t * M_PI / tBins;
+    printf("Line %d: theta %6.2f deg, rho %5d, votes %ld\n", n, th*180/M_PI, rho, acc[best]);
+    for (int y = 0; y < iH; y++) {
+      for (int x = 0; x < iW; x++) {
+        if (fabs(x*cos(th) + y*sin(th) - rho) < 1.0) {
+          rarray[y*iW+x] = 255;
+        }
+      }
+    }
+    // Suppress the neighborhood of the line before picking the next one
+    for (int dt = -2; dt <= 2; dt++) {
+      for (int dr = -4; dr <= 4; dr++) {
+        int r = best % rBins + dr;
+        if ((r >= 0) && (r < rBins)) {
+          acc[((t + dt + tBins) % tBins)*rBins + r] = 0;
+        }
+      }
+    }
+  }
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  inst2->~HoughT();
+  delete[] mem;
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  if (mismatches) {
+    cout << "FAILED - " << mismatches << " accumulator mismatches" << endl;
+    CCS_RETURN(1);
+  }
+  cout << "PASSED" << endl;
+  CCS_RETURN(0);
+}
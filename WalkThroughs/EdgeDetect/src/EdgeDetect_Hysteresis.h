@@ -0,0 +1,508 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_HYSTERESIS_H_
+#define _INCLUDED_EDGEDETECT_HYSTERESIS_H_
+
+// Streaming hysteresis thresholding stage, chained after the thinned
+// magnitude output of EdgeDetect_NMS (or the magnitude output of the edge
+// detect designs). Pixels at or above highIn are strong, pixels at or above
+// lowIn are weak. A pixel of line y is an edge when its 8-connected weak
+// component, over lines 0 to y+lookLines, reaches a strong pixel. Strength
+// propagates down and along a line without limit and up by lookLines lines,
+// so a line is output lookLines lines after it is read.
+//
+// Labels are recycled every line. Three blocks split the work:
+//   label   - II=1 on the input. Splits every line into runs of weak pixels
+//             numbered from 1 on each line, and sends a link record for each
+//             previous line run a run touches. Only run numbers are kept in
+//             the line buffer, there is no table lookup per pixel. The weak
+//             pixels are passed on packed in words.
+//   resolve - keeps one union-find table per line of the lookahead window,
+//             each holding a line of runs. A run joins the runs of its own
+//             line that continue the same previous line component, with
+//             union by rank so every find takes at most findSteps table
+//             reads. Each previous line component records the run it
+//             continues into. Once a line is linked, the line lookLines above
+//             it is decided by following those records down the window, and
+//             its table is reused for the next line. It runs at its own pace
+//             behind the links FIFO.
+//   output  - expands the weak pixels and their run decisions back to the
+//             edge map at II=1.
+//
+// resolve spends one cycle per record plus one per dependent table access,
+// the fields of a table entry are separate RAMs read at the same address.
+// It falls behind label on dense lines and catches up on quiet ones, the
+// decisions of the last lookLines lines of a frame are done in the blanking
+// after it. The host model keeps the counts for the testbench to check
+// both costs.
+
+#include <ac_int.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+#include <mc_scverify.h>
+
+// lookLines - lines below a pixel searched for a strong pixel, sets the
+//             latency and the number of union-find tables (lookLines+1)
+template <int imageWidth, int imageHeight, int lookLines = 4>
+class EdgeDetect_Hysteresis
+{
+  // Define some bit-accurate types to use in this model
+  typedef uint9                  magType;      // 9-bit unsigned magnitute
+  typedef ac_int<1,false>        edgeType;     // edge / no edge
+
+  static_assert(lookLines >= 1, "The union-find tables of the previous and current line must differ");
+
+public:
+  enum {
+    lineRuns  = (imageWidth+1)/2,              // runs on a line are separated by at least one pixel
+    findSteps = ac::nbits<lineRuns>::val,      // union by rank bounds the tree height
+    tables    = lookLines+1,                   // union-find tables, one per line of the window
+    weakBits  = 16,                            // weak pixels packed per word
+    linkDepth = 1024                           // links FIFO depth, set in the tcl
+  };
+
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+  typedef magType threshType;
+  typedef ac_int<ac::nbits<lineRuns>::val,false> runType;     // run number on a line, 0 is background
+  typedef ac_int<ac::nbits<findSteps>::val,false> rankType;   // union by rank tree height
+  typedef ac_int<ac::nbits<tables-1>::val,false> tableIdx;    // union-find table of a line
+  typedef ac_int<weakBits,false> weakWord;                    // weak pixels, first pixel in the LSB
+
+  //--------------------------------------------------------------------------
+  // Struct: linkRecord
+  //   Links of run cur to up to two previous line runs a and b, 0 for none.
+  //   The record with end set closes run cur, with strong set if the run
+  //   has a strong pixel. The last pixel of every line writes a record with
+  //   eol set, cur holding the number of runs of the line, and eof set on
+  //   the last line.
+  struct linkRecord
+  {
+    runType cur;
+    runType a;
+    runType b;
+    bool    end;
+    bool    strong;
+    bool    eol;
+    bool    eof;
+#ifndef __SYNTHESIS__
+    unsigned long cycle; // host model, label cycle the record was written in
+#endif
+  };
+
+#ifndef __SYNTHESIS__
+  // Host side statistics of the last frame
+  unsigned long hyRuns;          // weak runs
+  unsigned long hyLinks;         // link records
+  unsigned long hyResolveCycles; // cycles resolve is busy
+  unsigned long hyPeakWait;      // longest a link record waits in the FIFO, bounds its occupancy
+  unsigned long hyResolveLag;    // cycles from the last pixel to the last decision
+#endif
+
+  EdgeDetect_Hysteresis() {
+#ifndef __SYNTHESIS__
+    hyRuns = 0;
+    hyLinks = 0;
+    hyResolveCycles = 0;
+    hyPeakWait = 0;
+    hyResolveLag = 0;
+    hySteps = 0;
+#endif
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Thresholds the magnitude
+  //   stream into a binary edge stream.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<magType>   &magn,
+                      maxW                  &widthIn,
+                      maxH                  &heightIn,
+                      threshType            &lowIn,
+                      threshType            &highIn,
+                      ac_channel<edgeType>  &edges)
+  {
+    label(magn, widthIn, heightIn, lowIn, highIn, links, weak);
+    resolve(links, decisions);
+    output(weak, decisions, widthIn, heightIn, edges);
+  }
+
+private:
+  // Static interconnect channels (FIFOs) between blocks. weak holds the
+  // lookahead window, output expands a line once resolve has decided it.
+  ac_channel<linkRecord>  links;
+  ac_channel<weakWord>    weak;      // weak pixels of the lines not yet output
+  ac_channel<bool>        decisions; // run reaches a strong pixel, in run order
+#ifndef __SYNTHESIS__
+  unsigned long           hySteps;     // host model, resolve cycles of the current record
+#endif
+
+  //--------------------------------------------------------------------------
+  // Function: label
+  //   Number the weak runs of every line and link them to the previous line
+  //   runs they touch
+#pragma hls_design
+  void label(ac_channel<magType>    &magn_in,
+             maxW                   &widthIn,
+             maxH                   &heightIn,
+             threshType             &lowIn,
+             threshType             &highIn,
+             ac_channel<linkRecord> &links_out,
+             ac_channel<weakWord>   &weak_out)
+  {
+    // Run numbers of the previous line, overwritten by the current line
+    // behind the read - Mapped to RAM
+    runType    lab_buf[imageWidth];
+    runType    numRuns;
+    runType    labL, labC, labR; // previous line runs at x-1, x, x+1
+    runType    lastPrev = 0;     // last previous line run linked to the current run
+    runType    lab;
+    linkRecord rec;
+    weakWord   wbits = 0;
+    magType    mag;
+    bool       weak, inRun, runStrong = false;
+#ifndef __SYNTHESIS__
+    unsigned long cycle = 0;
+    hyRuns = 0;
+    hyLinks = 0;
+#endif
+
+    // Remove loop upperbounds for RTL code coverage
+    // Use bit accurate data types on loop iterator
+    HYROW: for (maxH y = 0; ; y++) {
+      inRun = false;
+      numRuns = 0;
+      labC = 0;
+      labR = (y > 0) ? lab_buf[0] : runType(0);
+      HYCOL: for (maxW x = 0; ; x++) {
+        // Slide the previous line runs
+        labL = labC;
+        labC = labR;
+        labR = ((y > 0) & (x < maxW(widthIn-1))) ? lab_buf[x+1] : runType(0);
+
+        mag = magn_in.read(); // Read streaming interface
+        weak = (mag >= lowIn);
+        rec.cur = numRuns;
+        rec.a = 0;
+        rec.b = 0;
+        rec.end = inRun & !weak; // the run ended on the previous pixel
+        rec.strong = runStrong;
+        rec.eol = (x == maxW(widthIn-1));
+        rec.eof = rec.eol & (y == maxH(heightIn-1));
+        lab = 0;
+        if (weak) {
+          if (!inRun) { // start a new run, touching x-1 to x+1 above
+            numRuns++;
+            runStrong = false;
+            rec.a = (labL != 0) ? labL : ((labC != 0) ? labC : labR);
+            rec.b = ((labR != 0) & (labR != rec.a)) ? labR : runType(0);
+            lastPrev = (rec.b != 0) ? rec.b : rec.a;
+          } else if ((labR != 0) & (labR != lastPrev)) { // a new run above at x+1
+            rec.a = labR;
+            lastPrev = labR;
+          }
+          runStrong = runStrong | (mag >= highIn);
+          rec.cur = numRuns;
+          lab = numRuns;
+          if (rec.eol) { // the line ends the run
+            rec.end = true;
+            rec.strong = runStrong;
+          }
+        }
+        inRun = weak;
+        lab_buf[x] = lab;
+
+        if (rec.end | (rec.a != 0) | rec.eol) { // Write link record, at most one per pixel
+#ifndef __SYNTHESIS__
+          rec.cycle = cycle;
+          hyLinks++;
+#endif
+          links_out.write(rec);
+        }
+        // Pack the weak pixels, a line starts a new word
+        wbits.set_slc(x & (weakBits-1), edgeType(weak));
+        if (((x & (weakBits-1)) == weakBits-1) | rec.eol) {
+          weak_out.write(wbits); // Write streaming interface
+        }
+#ifndef __SYNTHESIS__
+        cycle++;
+#endif
+        // programmable width exit condition
+        if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+#ifndef __SYNTHESIS__
+      hyRuns += numRuns;
+#endif
+      //programmable height exit condition
+      if (y == maxH(heightIn-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: find
+  //   Root of a run in the union-find table of a line, bounded by findSteps.
+  //   The other fields of the root are read with its last step
+  runType find(const runType parent[tables][lineRuns+1], tableIdx t, runType n)
+  {
+    runType p;
+    FIND: for (int i = 0; i < findSteps; i++) {
+      p = parent[t][n];
+#ifndef __SYNTHESIS__
+      hySteps++;
+#endif
+      if (p == n)
+        break;
+      n = p;
+    }
+    return n;
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: decide
+  //   Follow the component of run r of table t down the window to the table
+  //   of the last line linked, or to the line it ends on, and return whether
+  //   it reaches a strong pixel. The component of the next line records
+  //   where the walk ended, so the decision of the next line starts there
+  //   and takes one step instead of lookLines
+  bool decide(const runType parent[tables][lineRuns+1],
+              const bool    strong[tables][lineRuns+1],
+              const runType next[tables][lineRuns+1],
+              tableIdx      jumpT[tables][lineRuns+1],
+              runType       jumpR[tables][lineRuns+1],
+              tableIdx      t,
+              tableIdx      last,
+              runType       r)
+  {
+    runType  c = find(parent, t, r);
+    runType  n, c1;
+    tableIdx t1;
+    if ((t != last) && (next[t][c] != 0)) {
+      t1 = (t == tables-1) ? tableIdx(0) : tableIdx(t+1);
+      c1 = find(parent, t1, next[t][c]);
+      if (jumpR[t][c] != 0) { // where the walk of the previous line ended
+        n = jumpR[t][c];
+        t = jumpT[t][c];
+        c = n;
+#ifndef __SYNTHESIS__
+        hySteps++;
+#endif
+      } else {
+        t = t1;
+        c = c1;
+      }
+      WALK: for (int k = 0; k < lookLines; k++) {
+        if (t == last)
+          break;
+        n = next[t][c];
+        if (n == 0)
+          break; // the component ends on this line
+        t = (t == tables-1) ? tableIdx(0) : tableIdx(t+1);
+        c = find(parent, t, n);
+      }
+      jumpT[t1][c1] = t; // written with the decision
+      jumpR[t1][c1] = c;
+    }
+    return strong[t][c];
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: resolve
+  //   Join the runs of every line through the previous line components they
+  //   continue, then decide the line lookLines above
+#pragma hls_design
+  void resolve(ac_channel<linkRecord> &links_in,
+               ac_channel<bool>       &decisions_out)
+  {
+    // Union-find tables, one per line of the window - Mapped to RAM
+    runType    parent[tables][lineRuns+1];
+    rankType   rank[tables][lineRuns+1];
+    bool       strong[tables][lineRuns+1]; // component reaches a strong pixel, valid at roots
+    runType    next[tables][lineRuns+1];   // run of the next line a component continues into, 0 for none
+    tableIdx   jumpT[tables][lineRuns+1];  // table and root the walk of the previous line ended on,
+    runType    jumpR[tables][lineRuns+1];  // 0 for none
+    runType    numRuns[tables];            // runs of the line held in each table
+    tableIdx   cur = 0;                    // table of the line being linked
+    tableIdx   prev = tables-1;            // table of the previous line
+    tableIdx   oldest = 0;                 // table of the oldest line not yet decided
+    tableIdx   held = 0;                   // lines held before the current one
+    linkRecord rec;
+    runType    lastCur = 0, q, c, n, rq;
+    runType    root = 0;                   // root of the current run
+    rankType   rootRank = 0;
+    bool       rootStrong = false;         // written to the table when the run ends
+    bool       done = false;
+#ifndef __SYNTHESIS__
+    unsigned long now = 0;         // resolve cycle
+    hyPeakWait = 0;
+    hyResolveCycles = 0;
+#endif
+
+    LINK: while (!done) {
+      rec = links_in.read(); // Read streaming interface
+#ifndef __SYNTHESIS__
+      now = (now > rec.cycle) ? now : rec.cycle;
+      hyPeakWait = (now - rec.cycle > hyPeakWait) ? now - rec.cycle : hyPeakWait;
+      hySteps = 1;
+#endif
+      if ((rec.cur != 0) & (rec.cur != lastCur)) { // first record of a run
+        parent[cur][rec.cur] = rec.cur;
+        rank[cur][rec.cur] = 0;
+        next[cur][rec.cur] = 0;
+        jumpR[cur][rec.cur] = 0;
+        root = rec.cur;
+        rootRank = 0;
+        rootStrong = false;
+        lastCur = rec.cur;
+#ifndef __SYNTHESIS__
+        hySteps++;
+#endif
+      }
+      // Join the previous line runs. A component not continued yet
+      // continues into this run, otherwise this run joins the run it
+      // continues into, keeping the higher rank root
+      LJOIN: for (int k = 0; k < 2; k++) {
+        q = (k == 0) ? rec.a : rec.b;
+        if (q != 0) {
+          c = find(parent, prev, q);
+          n = next[prev][c];
+          if (n == 0) {
+            next[prev][c] = rec.cur;
+            rootStrong = rootStrong | strong[prev][c];
+#ifndef __SYNTHESIS__
+            hySteps++;
+#endif
+          } else {
+            rq = find(parent, cur, n);
+            if (rq != root) {
+              if (rank[cur][rq] < rootRank) {
+                parent[cur][rq] = root;
+              } else {
+                parent[cur][root] = rq;
+                if (rank[cur][rq] == rootRank) {
+                  rank[cur][rq] = rootRank + 1;
+                }
+                rootRank = rank[cur][rq];
+                root = rq;
+              }
+              rootStrong = rootStrong | strong[cur][rq];
+#ifndef __SYNTHESIS__
+              hySteps++;
+#endif
+            }
+          }
+        }
+      }
+      if (rec.end) {
+        strong[cur][root] = rootStrong | rec.strong;
+#ifndef __SYNTHESIS__
+        hySteps++;
+#endif
+      }
+      if (rec.eol) {
+        numRuns[cur] = rec.cur;
+        lastCur = 0;
+        // Decide the oldest line once the window is full, every line left
+        // at the end of the frame
+        DLINE: for (;;) {
+          if ((held != lookLines) & !rec.eof)
+            break;
+          DRUN: for (runType r = 1; r <= numRuns[oldest]; r++) {
+            decisions_out.write(decide(parent, strong, next, jumpT, jumpR, oldest, cur, r)); // Write streaming interface
+#ifndef __SYNTHESIS__
+            hySteps++;
+#endif
+          }
+          if (oldest == cur)
+            break;
+          oldest = (oldest == tables-1) ? tableIdx(0) : tableIdx(oldest+1);
+          if (!rec.eof) {
+            held--;
+          }
+        }
+        held++;
+        prev = cur;
+        cur = (cur == tables-1) ? tableIdx(0) : tableIdx(cur+1);
+        done = rec.eof;
+      }
+#ifndef __SYNTHESIS__
+      now += hySteps;
+      hyResolveCycles += hySteps;
+#endif
+    }
+#ifndef __SYNTHESIS__
+    hyResolveLag = now - rec.cycle;
+#endif
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: output
+  //   Expand the weak pixels and their run decisions back to the edge map
+#pragma hls_design
+  void output(ac_channel<weakWord> &weak_in,
+              ac_channel<bool>     &decisions_in,
+              maxW                 &widthIn,
+              maxH                 &heightIn,
+              ac_channel<edgeType> &edges)
+  {
+    weakWord wbits = 0;
+    bool     weak, inRun, edge = false;
+
+    OROW: for (maxH y = 0; ; y++) {
+      inRun = false;
+      OCOL: for (maxW x = 0; ; x++) {
+        if ((x & (weakBits-1)) == 0) {
+          wbits = weak_in.read(); // Read streaming interface
+        }
+        weak = wbits[x & (weakBits-1)];
+        if (weak & !inRun) { // first pixel of a run
+          edge = decisions_in.read(); // Read streaming interface
+        }
+        inRun = weak;
+        edges.write(weak & edge); // Write streaming interface
+        // programmable width exit condition
+        if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      //programmable height exit condition
+      if (y == maxH(heightIn-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+
+};
+
+#endif
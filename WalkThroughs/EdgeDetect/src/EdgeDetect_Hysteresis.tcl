@@ -0,0 +1,52 @@
+#------------------------------------------------------------
+# Sliding Window Walkthrough - Hysteresis thresholding
+#------------------------------------------------------------
+
+# Establish the location of this script and use it to reference all
+# other files in this example
+set sfd [file dirname [info script]]
+  
+# Reset the options to the factory defaults
+options defaults
+options set /Input/CppStandard c++11
+
+project new
+
+flow package require /SCVerify
+flow package option set /SCVerify/USE_CCS_BLOCK true
+flow package option set /SCVerify/INVOKE_ARGS "[file join $sfd image people_gray.bmp] out_algorithm.bmp out_hw.bmp"
+
+solution file add {$MGC_HOME/shared/include/bmpUtil/bmp_io.cpp} -type C++ -exclude true
+solution file add [file join $sfd EdgeDetect_Hysteresis_tb.cpp] -type C++
+options set Output/OutputVHDL false
+
+go analyze
+directive set -DESIGN_HIERARCHY {{EdgeDetect_Hysteresis<1296, 864, 4>} {EdgeDetect_Hysteresis<1296, 864, 4>::label} {EdgeDetect_Hysteresis<1296, 864, 4>::resolve} {EdgeDetect_Hysteresis<1296, 864, 4>::output}}
+go compile
+solution library add nangate-45nm_beh -file {$MGC_HOME/pkgs/siflibs/nangate/nangate-45nm_beh.lib} -- -rtlsyntool OasysRTL
+solution library add ccs_sample_mem -file {$MGC_HOME/pkgs/siflibs/ccs_sample_mem.lib}
+
+go libraries
+directive set -CLOCKS {clk {-CLOCK_PERIOD 3.33 -CLOCK_EDGE rising -CLOCK_UNCERTAINTY 0.0 -CLOCK_HIGH_TIME 1.665 -RESET_SYNC_NAME rst -RESET_ASYNC_NAME arst_n -RESET_KIND sync -RESET_SYNC_ACTIVE high -RESET_ASYNC_ACTIVE low -ENABLE_ACTIVE high}}
+go assembly
+directive set /EdgeDetect_Hysteresis<1296,864,4>/label/core/lab_buf:rsc -BLOCK_SIZE 1296
+directive set /EdgeDetect_Hysteresis<1296,864,4>/label/core/lab_buf:rsc -MAP_TO_MODULE ccs_sample_mem.ccs_ram_sync_1R1W
+directive set /EdgeDetect_Hysteresis<1296,864,4>/label/core/HYROW/HYCOL -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_Hysteresis<1296,864,4>/resolve/core/parent:rsc -MAP_TO_MODULE ccs_sample_mem.ccs_ram_sync_singleport
+directive set /EdgeDetect_Hysteresis<1296,864,4>/resolve/core/rank:rsc -MAP_TO_MODULE ccs_sample_mem.ccs_ram_sync_singleport
+directive set /EdgeDetect_Hysteresis<1296,864,4>/resolve/core/strong:rsc -MAP_TO_MODULE ccs_sample_mem.ccs_ram_sync_singleport
+directive set /EdgeDetect_Hysteresis<1296,864,4>/resolve/core/next:rsc -MAP_TO_MODULE ccs_sample_mem.ccs_ram_sync_singleport
+directive set /EdgeDetect_Hysteresis<1296,864,4>/resolve/core/jumpT:rsc -MAP_TO_MODULE ccs_sample_mem.ccs_ram_sync_singleport
+directive set /EdgeDetect_Hysteresis<1296,864,4>/resolve/core/jumpR:rsc -MAP_TO_MODULE ccs_sample_mem.ccs_ram_sync_singleport
+directive set /EdgeDetect_Hysteresis<1296,864,4>/output/core/OROW/OCOL -PIPELINE_INIT_INTERVAL 1
+# Links wait up to linkDepth records, weak holds the lookahead window plus
+# the resolve lag, (4+3) lines of 81 words, decisions hold a line of runs
+directive set /EdgeDetect_Hysteresis<1296,864,4>/links:cns -FIFO_DEPTH 1024
+directive set /EdgeDetect_Hysteresis<1296,864,4>/weak:cns -FIFO_DEPTH 567
+directive set /EdgeDetect_Hysteresis<1296,864,4>/decisions:cns -FIFO_DEPTH 648
+directive set /EdgeDetect_Hysteresis<1296,864,4>/widthIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_Hysteresis<1296,864,4>/heightIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_Hysteresis<1296,864,4>/lowIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_Hysteresis<1296,864,4>/highIn:rsc -MAP_TO_MODULE {[DirectInput]}
+go architect
+go extract
@@ -0,0 +1,342 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_CircularBuf.h"
+#include "EdgeDetect_NMS.h"
+#include "EdgeDetect_Hysteresis.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <mc_scverify.h>
+
+// Host reference for hysteresis, flood fill of the weak pixels from every
+// strong pixel over the whole frame
+static void hysteresisRef(const int *mag, int w, int h, int low, int high, unsigned char *out)
+{
+  std::vector<int> stack;
+  for (int i = 0; i < w*h; i++) {
+    out[i] = 0;
+  }
+  for (int i = 0; i < w*h; i++) {
+    if ((mag[i] >= high) && !out[i]) {
+      out[i] = 1;
+      stack.push_back(i);
+      while (!stack.empty()) {
+        int p = stack.back();
+        stack.pop_back();
+        int px = p % w;
+        int py = p / w;
+        for (int dy = -1; dy <= 1; dy++) {
+          for (int dx = -1; dx <= 1; dx++) {
+            int nx = px + dx;
+            int ny = py + dy;
+            if ((nx >= 0) && (nx < w) && (ny >= 0) && (ny < h) && !out[ny*w+nx] && (mag[ny*w+nx] >= low)) {
+              out[ny*w+nx] = 1;
+              stack.push_back(ny*w+nx);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Host reference for hysteresis with a bounded lookahead, each line is
+// decided once the lines up to look below it are joined. Union-find over
+// the pixels, independent of the run based design
+static int findRef(std::vector<int> &parent, int n)
+{
+  while (parent[n] != n) {
+    parent[n] = parent[parent[n]];
+    n = parent[n];
+  }
+  return n;
+}
+
+static void lookaheadRef(const int *mag, int w, int h, int low, int high, int look, unsigned char *out)
+{
+  std::vector<int> parent(w*h);
+  std::vector<char> strong(w*h, 0);
+  for (int t = 0; t < h+look; t++) {
+    // Join line t to its left and upper neighbours
+    for (int x = 0; (t < h) && (x < w); x++) {
+      int i = t*w + x;
+      parent[i] = i;
+      strong[i] = (mag[i] >= high);
+      if (mag[i] < low) {
+        continue;
+      }
+      for (int k = 0; k < 4; k++) {
+        int nx = x + ((k == 0) ? -1 : k-2);
+        int ny = (k == 0) ? t : t-1;
+        if ((nx >= 0) && (nx < w) && (ny >= 0) && (mag[ny*w+nx] >= low)) {
+          int a = findRef(parent, i);
+          int b = findRef(parent, ny*w+nx);
+          if (a != b) {
+            parent[a] = b;
+            strong[b] = strong[b] | strong[a];
+          }
+        }
+      }
+    }
+    // Decide line t-look
+    int y = t - look;
+    for (int x = 0; (y >= 0) && (y < h) && (x < w); x++) {
+      int i = y*w + x;
+      out[i] = (mag[i] >= low) && strong[findRef(parent, i)];
+    }
+  }
+}
+
+// Run one frame through a hysteresis instance, check it against the
+// lookahead reference and report the edges missed against full frame
+// hysteresis. Returns the number of errors
+template <class hyT>
+static unsigned long runFrame(hyT &inst, const char *name, const int *mag, int iW, int iH,
+                              typename hyT::threshType lowIn, typename hyT::threshType highIn,
+                              unsigned char *edge_hw)
+{
+  typename hyT::maxW widthIn = iW;
+  typename hyT::maxH heightIn = iH;
+  ac_channel<uint9>            thin_hy;
+  ac_channel<ac_int<1,false> > edges;
+  unsigned char *edge_ref = new unsigned char[iH*iW];  // lookahead hysteresis
+  unsigned char *edge_full = new unsigned char[iH*iW]; // full frame hysteresis
+
+  for (int i = 0; i < iH*iW; i++) {
+    thin_hy.write(mag[i]);
+  }
+  inst.run(thin_hy,widthIn,heightIn,lowIn,highIn,edges);
+
+  lookaheadRef(mag, iW, iH, lowIn.to_int(), highIn.to_int(), hyT::tables-1, edge_ref);
+  hysteresisRef(mag, iW, iH, lowIn.to_int(), highIn.to_int(), edge_full);
+
+  unsigned long errors = 0;
+  unsigned long numEdges = 0;
+  unsigned long missed = 0;
+  unsigned long extra = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    edge_hw[i] = edges.read();
+    errors += (edge_hw[i] != edge_ref[i]);
+    numEdges += edge_hw[i];
+    missed += (edge_full[i] && !edge_hw[i]);
+    extra += (!edge_full[i] && edge_hw[i]);
+  }
+  errors += edges.size();
+
+  printf("%s, lookahead %d lines: hysteresis thresholds low %d high %d\n", name, (int)hyT::tables-1, lowIn.to_int(), highIn.to_int());
+  printf("  Edge pixels %lu of %d, %lu mismatches against the lookahead reference\n", numEdges, iH*iW, errors);
+  printf("  Edge pixels missed against full frame hysteresis %lu\n", missed);
+  printf("  Edge pixels not in full frame hysteresis %lu\n", extra);
+  printf("  Weak runs %lu, link records %lu\n", inst.hyRuns, inst.hyLinks);
+  // resolve runs behind label, at most one link record per pixel cycle
+  printf("  Resolve busy %lu cycles for %d pixel cycles, link records wait up to %lu cycles\n",
+         inst.hyResolveCycles, iH*iW, inst.hyPeakWait);
+  printf("  Last decision %lu cycles after the last pixel\n", inst.hyResolveLag);
+  if (inst.hyPeakWait > (unsigned long)hyT::linkDepth) {
+    printf("  Link records back up beyond the FIFO depth %d\n", (int)hyT::linkDepth);
+    errors++;
+  }
+  // The upstream designs leave a line of blanking after every frame, the
+  // last lines must be decided in it
+  if (inst.hyResolveLag > (unsigned long)iW) {
+    printf("  Decisions of the last lines need more than a line of blanking\n");
+    errors++;
+  }
+  delete[] edge_ref;
+  delete[] edge_full;
+  return errors;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  EdgeDetect_Algorithm             inst0;
+  EdgeDetect_CircularBuf<iW,iH>    inst1;
+  EdgeDetect_NMS<iW,iH>            inst2;
+  EdgeDetect_Hysteresis<iW,iH>     inst3;
+  EdgeDetect_Hysteresis<iW,iH,1>   inst4; // shortest lookahead
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  EdgeDetect_CircularBuf<iW,iH>::maxW widthIn = iW;
+  EdgeDetect_CircularBuf<iW,iH>::maxH heightIn = iH;
+  EdgeDetect_NMS<iW,iH>::maxW nmsWidthIn = iW;
+  EdgeDetect_NMS<iW,iH>::maxH nmsHeightIn = iH;
+  EdgeDetect_Hysteresis<iW,iH>::threshType lowIn = 40;
+  EdgeDetect_Hysteresis<iW,iH>::threshType highIn = 100;
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+  ac_channel<uint9>            thin;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+  int *thin_hw = new int[iH*iW];                   // bit-accurate thinned magnitude
+  unsigned char *edge_hw = new unsigned char[iH*iW];  // streaming hysteresis output
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1.run(dat_in,widthIn,heightIn,magn,angle);
+  inst2.run(magn,angle,nmsWidthIn,nmsHeightIn,thin);
+
+  // Capture the thinned magnitude
+  for (int i = 0; i < iH*iW; i++) {
+    thin_hw[i] = thin.read();
+  }
+
+  // Second frame, two serpentines of weak pixels running down the frame,
+  // the left one with a single strong pixel at its bottom end. Only the
+  // lookahead above it is marked
+  int *snake = new int[iH*iW];
+  for (int i = 0; i < iH*iW; i++) {
+    snake[i] = 0;
+  }
+  for (int half = 0; half < 2; half++) {
+    int x0 = half*iW/2 + 8;
+    int x1 = half*iW/2 + iW/2 - 8;
+    for (int y = 0; y < iH; y++) {
+      for (int x = x0; x <= x1; x++) {
+        bool across = ((y % 4) == 0);
+        bool down = (x == ((((y / 4) % 2) == 0) ? x1 : x0));
+        if (across || down) {
+          snake[y*iW+x] = lowIn.to_int() + 10;
+        }
+      }
+    }
+    if (half == 0) {
+      snake[(iH-4)*iW+x0] = highIn.to_int();
+    }
+  }
+
+  // Both frames with the shortest lookahead, then with the default one
+  unsigned long mismatches = 0;
+  mismatches += runFrame(inst4, "Frame 0", thin_hw, iW, iH, lowIn, highIn, edge_hw);
+  mismatches += runFrame(inst4, "Frame 1", snake, iW, iH, lowIn, highIn, edge_hw);
+  mismatches += runFrame(inst3, "Frame 1", snake, iW, iH, lowIn, highIn, edge_hw);
+  mismatches += runFrame(inst3, "Frame 0", thin_hw, iW, iH, lowIn, highIn, edge_hw);
+  hysteresisRef(thin_hw, iW, iH, lowIn.to_int(), highIn.to_int(), garray);
+  for (int i = 0; i < iH*iW; i++) {
+    rarray[i] = edge_hw[i] ? 255 : 0; // streaming hysteresis output
+    garray[i] = garray[i] ? 255 : 0;  // full frame hysteresis output
+  }
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (thin_hw);
+  delete (edge_hw);
+  delete (snake);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  if (mismatches) {
+    cout << "FAILED - " << mismatches << " errors" << endl;
+    CCS_RETURN(1);
+  }
+  cout << "PASSED" << endl;
+  CCS_RETURN(0);
+}
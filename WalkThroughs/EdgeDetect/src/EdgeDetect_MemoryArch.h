@@ -121,7 +121,7 @@ public:
         // Calculate derivative
         if (y > 0) {
           // wait till window ramp-up and adjust index i
-          dy[y-1][x] = pix2*kernel[0] + pix1*kernel[1] + pix0*kernel[2];
+          dy[y-1][x] = edgeKernel::apply(pix2, pix1, pix0);
         }
       }
     }
@@ -160,7 +160,7 @@ public:
         // Calculate derivative
         if (x > 0) {
           // wait till window ramp-up and adjust index j
-          dx[y][x-1] = pix2*kernel[0] + pix1*kernel[1] + pix0*kernel[2];
+          dx[y][x-1] = edgeKernel::apply(pix2, pix1, pix0);
         }
       }
     }
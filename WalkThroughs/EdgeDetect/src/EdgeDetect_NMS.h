@@ -0,0 +1,167 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_NMS_H_
+#define _INCLUDED_EDGEDETECT_NMS_H_
+
+// Streaming non-maximum suppression stage, chained after the magnitude and
+// angle outputs of the edge detect designs. Each magnitude is compared with
+// its two neighbors along the gradient direction, quantized to 4 directions,
+// and is zeroed unless it is a local maximum. Borders are replicated.
+
+#include <ac_fixed.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+
+// Include line buffer manager
+#include "sliding_window.h"
+#include <mc_scverify.h>
+
+template <int imageWidth, int imageHeight>
+class EdgeDetect_NMS
+{
+  // Define some bit-accurate types to use in this model
+  typedef uint9                  magType;      // 9-bit unsigned magnitute
+  typedef ac_fixed<8,3,true>     angType;      // 3 integer bit, 5 fractional bits for quantized angle -pi to pi
+  typedef ac_int<2,false>        dirType;      // gradient direction, 0 horizontal, 1 diagonal, 2 vertical, 3 anti-diagonal
+  typedef ac_int<11,false>       nmsType;      // magnitude with direction packed above it
+  typedef ac_fixed<12,3,false>   binType;      // direction bin boundary
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+  EdgeDetect_NMS() {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Thins the magnitude stream
+  //   using the angle stream.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<magType>   &magn,
+                      ac_channel<angType>   &angle,
+                      maxW                  &widthIn,
+                      maxH                  &heightIn,
+                      ac_channel<magType>   &edges)
+  {
+    nonMaxSuppress(magn, angle, widthIn, heightIn, edges);
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: quantizeDirection
+  //   Map the gradient angle to the direction of the edge normal, in image
+  //   coordinates with y pointing down. Angles fold onto 0 to pi, since
+  //   both neighbors along the normal are compared.
+  static dirType quantizeDirection(angType at)
+  {
+    const binType b1 = 0.392699082; // pi/8
+    const binType b3 = 1.178097245; // 3pi/8
+    const binType b5 = 1.963495408; // 5pi/8
+    const binType b7 = 2.748893572; // 7pi/8
+    binType a = (at < 0) ? binType(-at) : binType(at);
+    bool neg = at < 0;
+
+    if (a < b1) {
+      return 0;
+    } else if (a < b3) {
+      return neg ? 3 : 1;
+    } else if (a < b5) {
+      return 2;
+    } else if (a < b7) {
+      return neg ? 1 : 3;
+    }
+    return 0;
+  }
+
+private:
+  //--------------------------------------------------------------------------
+  // Function: nonMaxSuppress
+  //   Keep magnitudes that are not smaller than either neighbor along the
+  //   quantized gradient direction, zero the rest
+#pragma hls_design
+  void nonMaxSuppress(ac_channel<magType> &magn_in,
+                      ac_channel<angType> &angle_in,
+                      maxW                &widthIn,
+                      maxH                &heightIn,
+                      ac_channel<magType> &edges)
+  {
+    // Line buffers and window registers for magnitude and direction
+    SlidingWindow<nmsType,3,imageWidth> win;
+    nmsType pix;
+    magType mag, n0, n1;
+    dirType dir;
+
+    // Remove loop upperbounds for RTL code coverage
+    // Use bit accurate data types on loop iterator
+    NROW: for (maxH y = 0; ; y++) { // One extra iteration to ramp-up window
+      NCOL: for (maxW x = 0; ; x++) {
+        pix = 0;
+        if ((y < heightIn) & (x < widthIn)) {
+          // Read streaming interfaces
+          pix.set_slc(0, magn_in.read());
+          pix.set_slc(magType::width, quantizeDirection(angle_in.read()));
+        }
+        win.shift(pix, x, y, widthIn, heightIn);
+
+        if (win.valid(x, y)) {
+          mag = win.window[1][1].template slc<magType::width>(0);
+          dir = win.window[1][1].template slc<2>(magType::width);
+          // Neighbors along the gradient direction
+          if (dir == 0) {
+            n0 = win.window[1][0].template slc<magType::width>(0);
+            n1 = win.window[1][2].template slc<magType::width>(0);
+          } else if (dir == 1) {
+            n0 = win.window[0][0].template slc<magType::width>(0);
+            n1 = win.window[2][2].template slc<magType::width>(0);
+          } else if (dir == 2) {
+            n0 = win.window[0][1].template slc<magType::width>(0);
+            n1 = win.window[2][1].template slc<magType::width>(0);
+          } else {
+            n0 = win.window[0][2].template slc<magType::width>(0);
+            n1 = win.window[2][0].template slc<magType::width>(0);
+          }
+          edges.write(((mag >= n0) & (mag >= n1)) ? mag : magType(0)); // Write streaming interface
+        }
+        // programmable width exit condition
+        if (x == widthIn)
+          break;
+      }
+      // programmable height exit condition
+      if (y == heightIn)
+        break;
+    }
+  }
+
+};
+
+#endif
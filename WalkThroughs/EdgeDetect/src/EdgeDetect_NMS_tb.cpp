@@ -0,0 +1,206 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_CircularBuf.h"
+#include "EdgeDetect_NMS.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <mc_scverify.h>
+
+// Host reference for non-maximum suppression with replicated borders
+template <class nmsT>
+static void nmsRef(const int *mag, const double *ang, int w, int h, int *out)
+{
+  // Neighbor offsets {dx0, dy0, dx1, dy1} per direction
+  const int nb[4][4] = { { -1, 0, 1, 0 }, { -1, -1, 1, 1 }, { 0, -1, 0, 1 }, { 1, -1, -1, 1 } };
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      int d = nmsT::quantizeDirection(ac_fixed<8,3>(ang[y*w+x])).to_int();
+      int m = mag[y*w+x];
+      int n0 = mag[std::min(std::max(y+nb[d][1], 0), h-1)*w + std::min(std::max(x+nb[d][0], 0), w-1)];
+      int n1 = mag[std::min(std::max(y+nb[d][3], 0), h-1)*w + std::min(std::max(x+nb[d][2], 0), w-1)];
+      out[y*w+x] = ((m >= n0) && (m >= n1)) ? m : 0;
+    }
+  }
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  EdgeDetect_Algorithm             inst0;
+  EdgeDetect_CircularBuf<iW,iH>    inst1;
+  EdgeDetect_NMS<iW,iH>            inst2;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  EdgeDetect_CircularBuf<iW,iH>::maxW widthIn = iW;
+  EdgeDetect_CircularBuf<iW,iH>::maxH heightIn = iH;
+  EdgeDetect_NMS<iW,iH>::maxW nmsWidthIn = iW;
+  EdgeDetect_NMS<iW,iH>::maxH nmsHeightIn = iH;
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+  ac_channel<uint9>            edges;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+  int *magn_int = new int[iH*iW];    // algorithm magnitude as an integer
+  int *magn_hw = new int[iH*iW];     // bit-accurate magnitude
+  double *angle_hw = new double[iH*iW]; // bit-accurate angle
+  int *nms_alg = new int[iH*iW];     // reference suppression of the algorithm output
+  int *nms_hw = new int[iH*iW];      // reference suppression of the bit-accurate output
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1.run(dat_in,widthIn,heightIn,magn,angle);
+
+  // Capture the edge detect output and chain it into the suppression stage
+  ac_channel<uint9>            magn_nms;
+  ac_channel<ac_fixed<8,3> >   angle_nms;
+  for (int i = 0; i < iH*iW; i++) {
+    uint9 m = magn.read();
+    ac_fixed<8,3> a = angle.read();
+    magn_hw[i] = m;
+    angle_hw[i] = a.to_double();
+    magn_int[i] = (int)magn_orig[i];
+    magn_nms.write(m);
+    angle_nms.write(a);
+  }
+  inst2.run(magn_nms,angle_nms,nmsWidthIn,nmsHeightIn,edges);
+
+  nmsRef<EdgeDetect_NMS<iW,iH> >(magn_int, angle_orig, iW, iH, nms_alg);
+  nmsRef<EdgeDetect_NMS<iW,iH> >(magn_hw, angle_hw, iW, iH, nms_hw);
+
+  float sumErr = 0;
+  unsigned long mismatches = 0;
+  unsigned long kept = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    int hw = edges.read();
+    sumErr += abs(nms_alg[i] - hw);
+    mismatches += (hw != nms_hw[i]);
+    kept += (hw != 0);
+    rarray[i] = std::min(hw, 255);         // bit-accurate thinned edge output
+    garray[i] = std::min(nms_alg[i], 255); // algorithmic thinned edge output
+  }
+
+  printf("Magnitude: Manhattan norm per pixel %f\n",sumErr/(iH*iW));
+  printf("Suppression mismatches against bit-accurate reference %lu\n", mismatches);
+  printf("Edge pixels kept %lu of %d\n", kept, iH*iW);
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (magn_int);
+  delete (magn_hw);
+  delete (angle_hw);
+  delete (nms_alg);
+  delete (nms_hw);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  CCS_RETURN(0);
+}
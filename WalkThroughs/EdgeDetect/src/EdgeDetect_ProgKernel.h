@@ -0,0 +1,146 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_PROGKERNEL_H_
+#define _INCLUDED_EDGEDETECT_PROGKERNEL_H_
+
+// Revision History
+//    Rev 1 - Coding of edge detection algorithm in C++
+//    Rev 2 - Converted to using bit-accurate data types
+//            Calculated bit growth for internal variables
+//            Quantized angle values for 5 fractional bits -pi to pi
+//    Rev 3 - Switch to using HLSLIBS ac_math library for high performance
+//            math functions.
+//            Add support for verification using SCVerify
+//    Rev 4 - Refinining memory architecture for 1PPC
+//    Rev 5 - Modularized into hierarchy for performance
+//    Rev 6 - Recode to use single-port memories
+//    Rev 7 - Recode to make the design programmable for image size
+//    Rev 8 - Recode to use single-port memories in circular fashion
+//    Rev 9 - Recode to make the derivative kernel programmable
+//            Programmable kernel as a kernel policy of
+//            EdgeDetect_CircularBuf, coefficients are a top-level input
+
+#include "EdgeDetect_CircularBuf.h"
+
+//----------------------------------------------------------------------------
+// Struct: progKernel
+//   Run time programmable 3-tap derivative kernel, a drop-in for derivKernel.
+//   The coefficients are signed coefBits values applied as
+//   pix2*k[0] + pix1*k[1] + pix0*k[2]. The derivative is gradW bits wide and
+//   saturates when the kernel gain does not fit, gradW of 0 takes the worst
+//   case width for any coefBits kernel.
+template <int coefBits, int gradW = 0>
+struct progKernel
+{
+  typedef ac_int<coefBits,true> coefType;
+  struct coefs {
+    coefType k[3];
+  };
+
+  // Signed derivative width, worst case -3*2^(coefBits-1)*(2^pixelBits-1)
+  static constexpr int gradBits(int pixelBits)
+  {
+    return gradW ? gradW : 1 + edgeBits(3 * (1LL << (coefBits-1)) * ((1LL << pixelBits) - 1) - 1);
+  }
+
+  // Unsigned magnitude width, sqrt(dx^2 + dy^2) of the largest derivatives
+  static constexpr int magBits(int pixelBits)
+  {
+    return edgeBits(edgeSqrt(2 * (1LL << (gradBits(pixelBits)-1)) * (1LL << (gradBits(pixelBits)-1))));
+  }
+
+  template <int pixelBits>
+  static ac_int<gradBits(pixelBits),true> apply(const coefs &c, ac_int<pixelBits,false> pix2,
+                                                 ac_int<pixelBits,false> pix1, ac_int<pixelBits,false> pix0)
+  {
+    // Result of 3 taps of pixelBits x coefBits
+    ac_int<pixelBits+coefBits+2,true> acc = pix2*c.k[0] + pix1*c.k[1] + pix0*c.k[2];
+    // Saturate to the derivative width
+    ac_fixed<gradBits(pixelBits),gradBits(pixelBits),true,AC_TRN,AC_SAT> sat = acc;
+    return sat.to_int();
+  }
+};
+
+//----------------------------------------------------------------------------
+// Struct: progKernelConfig
+//   EdgeDetect_CircularBuf options of the programmable kernel design
+template <int coefBits, int gradBits>
+struct progKernelConfig : circularBufConfig
+{
+  typedef progKernel<coefBits, gradBits> kernelT;
+};
+
+// coefBits - signed width of each programmable kernel coefficient
+// gradBits - derivative width, defaults to the worst case for any kernel
+//            with coefBits coefficients, narrower widths saturate
+template <int imageWidth, int imageHeight, int coefBits = 5,
+          int gradBits = progKernel<coefBits>::gradBits(8)>
+class EdgeDetect_ProgKernel : public EdgeDetect_CircularBuf<imageWidth, imageHeight, progKernelConfig<coefBits, gradBits> >
+{
+  typedef EdgeDetect_CircularBuf<imageWidth, imageHeight, progKernelConfig<coefBits, gradBits> > base;
+  typedef typename base::pixelType pixelType;
+  typedef typename base::magType   magType;
+  typedef typename base::angType   angType;
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef typename base::maxW maxW;
+  typedef typename base::maxH maxH;
+  // Programmable kernel coefficient, applied as pix2*k[0] + pix1*k[1] + pix0*k[2]
+  typedef typename progKernel<coefBits, gradBits>::coefType coefType;
+  typedef typename base::kernelCoefs kernelType;
+  // Output types, used in testbench
+  typedef magType magOutType;
+  typedef angType angOutType;
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Combines vertical and
+  //   horizontal derivative and magnitude/angle computation of
+  //   EdgeDetect_CircularBuf with the kernel coefficients of kernelIn.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<pixelType> &dat_in,
+                      maxW                  &widthIn,
+                      maxH                  &heightIn,
+                      kernelType            &kernelIn,
+                      ac_channel<magType>   &magn,
+                      ac_channel<angType>   &angle) 
+  {
+    this->verticalDerivative(dat_in, widthIn, heightIn, this->dat, this->dy, kernelIn);
+    this->horizontalDerivative(this->dat, widthIn, heightIn, this->dx, kernelIn);
+    this->magnitudeAngle(this->dx, this->dy, widthIn, heightIn, magn, angle);
+  }
+};
+
+#endif
+
@@ -0,0 +1,236 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_ProgKernel.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <mc_scverify.h>
+
+// Magnitude of a hardware pixel must be within 1 or 1% of the reference and
+// the angle within one 1/32 step of the quantized angle
+static bool kernelMismatch(double magRef, double angRef, int magHw, double angHw)
+{
+  double magTol = (magRef > 100) ? magRef / 100 : 1;
+  return (fabs(floor(magRef) - magHw) > magTol) || (fabs(angRef - angHw) > 1.0/32);
+}
+
+//----------------------------------------------------------------------------
+// Function: runKernels
+//   Load each kernel into the same EdgeDetect_ProgKernel instance on
+//   successive frames and compare every pixel with EdgeDetect_Algorithm using
+//   the same coefficients. The reference derivatives are saturated to the
+//   gradBits range like the hardware. Returns the number of mismatches,
+//   hw_out gets the magnitude of the first frame.
+template <int iW, int iH, int gradBits>
+unsigned long runKernels(const char *name, unsigned char *dat_in_orig, const int kernels[][3],
+                         int numFrames, unsigned char *hw_out)
+{
+  typedef EdgeDetect_ProgKernel<iW,iH,5,gradBits> DUT;
+  EdgeDetect_Algorithm inst0;
+  DUT                  inst1;
+  const double gradMax = 1 << (gradBits-1);
+
+  typename DUT::maxW widthIn = iW;
+  typename DUT::maxH heightIn = iH;
+
+  ac_channel<uint8>                       dat_in;
+  ac_channel<typename DUT::magOutType>    magn;
+  ac_channel<typename DUT::angOutType>    angle;
+
+  double *dx = new double[iH*iW];
+  double *dy = new double[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+  unsigned long errors = 0;
+
+  for (int f = 0; f < numFrames; f++) {
+    typename DUT::kernelType kernelIn;
+    for (int k = 0; k < 3; k++) {
+      kernelIn.k[k] = kernels[f][k];
+    }
+    inst0.setKernel(kernels[f][0], kernels[f][1], kernels[f][2]);
+    inst0.verticalDerivative(dat_in_orig, dy);
+    inst0.horizontalDerivative(dat_in_orig, dx);
+    unsigned long saturated = 0;
+    for (int i = 0; i < iH*iW; i++) {
+      if ((dx[i] > gradMax-1) || (dx[i] < -gradMax) || (dy[i] > gradMax-1) || (dy[i] < -gradMax)) {
+        saturated++;
+      }
+      dx[i] = (dx[i] > gradMax-1) ? gradMax-1 : ((dx[i] < -gradMax) ? -gradMax : dx[i]);
+      dy[i] = (dy[i] > gradMax-1) ? gradMax-1 : ((dy[i] < -gradMax) ? -gradMax : dy[i]);
+    }
+    inst0.magnitudeAngle(dx, dy, magn_orig, angle_orig);
+
+    for (int i = 0; i < iH*iW; i++) {
+      dat_in.write(dat_in_orig[i]);
+    }
+
+    inst1.run(dat_in,widthIn,heightIn,kernelIn,magn,angle);
+
+    unsigned long mismatches = 0;
+    for (int i = 0; i < iH*iW; i++) {
+      int hw = magn.read();
+      double angHw = angle.read().to_double();
+      if (kernelMismatch(magn_orig[i], angle_orig[i], hw, angHw)) {
+        mismatches++;
+      }
+      if ((f == 0) && hw_out) {
+        hw_out[i] = hw;
+      }
+    }
+    printf("%s kernel {%d, %d, %d}: %lu saturated pixels, %lu mismatches\n", name,
+           kernels[f][0], kernels[f][1], kernels[f][2], saturated, mismatches);
+    errors += mismatches;
+  }
+
+  delete [] dx;
+  delete [] dy;
+  delete [] magn_orig;
+  delete [] angle_orig;
+  return errors;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  EdgeDetect_Algorithm inst0;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  // Kernels loaded into the same hardware on successive frames, the
+  // reference kernel, a scaled, a smoothing and an asymmetric kernel. The
+  // derivative of the default build holds any 5-bit kernel
+  const int numFrames = 4;
+  const int kernels[numFrames][3] = { { 1, 0, -1 }, { 3, 0, -3 }, { 1, 2, 1 }, { -2, 0, 1 } };
+  // A 10-bit derivative saturates (AC_SAT) for large kernel gains
+  const int numSatFrames = 3;
+  const int satKernels[numSatFrames][3] = { { 1, 0, -1 }, { 15, 0, -15 }, { -16, -16, -16 } };
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  unsigned char *hw_out = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+
+  for (int i = 0; i < iH*iW; i++) {
+    dat_in_orig[i] = rarray[i]; // just using red component (pseudo monochrome)
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+
+  unsigned long errors = 0;
+  errors += runKernels<iW,iH,progKernel<5>::gradBits(8)>("15-bit derivative", dat_in_orig, kernels, numFrames, hw_out);
+  errors += runKernels<iW,iH,10>("10-bit derivative", dat_in_orig, satKernels, numSatFrames, 0);
+
+  // Output images are from the reference kernel frame
+  for (int i = 0; i < iH*iW; i++) {
+    rarray[i] = hw_out[i];                      // bit-accurate monochrome edge-detect output
+    garray[i] = (unsigned char)magn_orig[i];    // original algorithmic edge-detect output
+  }
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (hw_out);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  if (errors) {
+    cout << "FAILED: " << errors << " mismatches" << endl;
+    CCS_RETURN(1);
+  }
+  cout << "PASSED" << endl;
+  CCS_RETURN(0);
+}
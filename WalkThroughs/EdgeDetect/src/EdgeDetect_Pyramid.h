@@ -0,0 +1,300 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_PYRAMID_H_
+#define _INCLUDED_EDGEDETECT_PYRAMID_H_
+
+// Multi-scale gradient pyramid in a single pass. The input frame is
+// streamed once, each level halves the image with a 2x2 box average on the
+// fly and feeds the next level, and every level runs the sliding window
+// derivative and magnitude/angle on its own image. Full, half and quarter
+// resolution outputs come out on separate channels.
+
+#include <ac_fixed.h>
+//This is Catapult's math library implementation, see docs for details
+#include <ac_math/ac_sqrt_pwl.h>
+#include <ac_math/ac_atan2_cordic.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+
+// Include constant kernel definition
+#include "edge_defs.h"
+// Include line buffer manager
+#include "sliding_window.h"
+#include <mc_scverify.h>
+
+//----------------------------------------------------------------------------
+// Class: EdgeDetect_PyramidDown
+//   Pass the pixels of a pyramid level through and build the next level
+//   with a 2x2 box average, replicating the last column and line of odd
+//   sizes. widthIn and heightIn are the full resolution size.
+template <int imageWidth, int imageHeight, int level>
+class EdgeDetect_PyramidDown
+{
+  typedef uint8                  pixelType;    // input pixel is 0-255
+  typedef ac_int<9,false>        pairType;     // sum of two pixels
+  typedef ac_int<10,false>       quadType;     // sum of four pixels
+  enum { levelWidth = (imageWidth + (1<<level) - 1) >> level };
+
+public:
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+
+  EdgeDetect_PyramidDown() {}
+
+#pragma hls_design
+  void run(ac_channel<pixelType> &dat_in,
+           maxW                  &widthIn,
+           maxH                  &heightIn,
+           ac_channel<pixelType> &dat_out,
+           ac_channel<pixelType> &dat_down)
+  {
+    // Horizontal pair sums of the even line - Mapped to RAM
+    pairType pair_buf[(levelWidth+1)/2];
+    pixelType pix;
+    pixelType left = 0;
+    pairType pair;
+    quadType quad;
+    maxW width = (widthIn + ((1<<level) - 1)) >> level;
+    maxH height = (heightIn + ((1<<level) - 1)) >> level;
+
+    DROW: for (maxH y = 0; ; y++) {
+      DCOL: for (maxW x = 0; ; x++) {
+        pix = dat_in.read(); // Read streaming interface
+        dat_out.write(pix);  // Pass thru to this level
+        if ((x & 1) == 0) {
+          left = pix;
+        }
+        // Complete a pair on odd columns, replicate the last column of odd widths
+        if (((x & 1) == 1) || (x == maxW(width-1))) {
+          pair = left + (((x & 1) == 1) ? pix : left);
+          if ((y & 1) == 0) {
+            pair_buf[x/2] = pair;
+          }
+          // Complete a block on odd lines, replicate the last line of odd heights
+          if (((y & 1) == 1) || (y == maxH(height-1))) {
+            quad = pair + (((y & 1) == 1) ? pair_buf[x/2] : pair);
+            dat_down.write((quad + 2) >> 2); // Write streaming interface, rounded average
+          }
+        }
+        // programmable width exit condition
+        if (x == maxW(width-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      // programmable height exit condition
+      if (y == maxH(height-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Class: EdgeDetect_PyramidLevel
+//   Sliding window derivatives and magnitude/angle of one pyramid level.
+//   widthIn and heightIn are the full resolution size.
+template <int imageWidth, int imageHeight, int level>
+class EdgeDetect_PyramidLevel
+{
+  // Define some bit-accurate types to use in this model
+  typedef uint8                  pixelType;    // input pixel is 0-255
+  enum {
+    levelWidth = (imageWidth + (1<<level) - 1) >> level,
+    gradW = edgeKernel::gradBits(8),           // -255 to 255
+    magW  = edgeKernel::magBits(8)             // 0 to 360
+  };
+  typedef ac_int<gradW,true>     gradType;     // Derivative range derived from the kernel coefficients
+  typedef ac_int<2*gradW,false>  sqType;       // Result of gradType x gradType
+  typedef ac_fixed<2*gradW+1,2*gradW+1,false> sumType; // Result of sqType + sqType fixed pt integer for squareroot
+  typedef ac_int<magW,false>     magType;      // unsigned magnitute result
+  typedef ac_fixed<8,3,true>     angType;      // 3 integer bit, 5 fractional bits for quantized angle -pi to pi
+
+  // Static interconnect channels (FIFOs) between blocks
+  ac_channel<gradType>       dy;
+  ac_channel<gradType>       dx;
+
+public:
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+
+  EdgeDetect_PyramidLevel() {}
+
+  void run(ac_channel<pixelType> &dat_in,
+           maxW                  &widthIn,
+           maxH                  &heightIn,
+           ac_channel<magType>   &magn,
+           ac_channel<angType>   &angle)
+  {
+    windowDerivative(dat_in, widthIn, heightIn, dx, dy);
+    magnitudeAngle(dx, dy, widthIn, heightIn, magn, angle);
+  }
+
+private:
+  //--------------------------------------------------------------------------
+  // Function: windowDerivative
+  //   Compute the horizontal and vertical derivatives on a 3x3 window
+#pragma hls_design
+  void windowDerivative(ac_channel<pixelType> &dat_in,
+                        maxW                  &widthIn,
+                        maxH                  &heightIn,
+                        ac_channel<gradType>  &dx,
+                        ac_channel<gradType>  &dy)
+  {
+    // Line buffers and window registers
+    SlidingWindow<pixelType,3,levelWidth> win;
+    pixelType pix;
+    maxW width = (widthIn + ((1<<level) - 1)) >> level;
+    maxH height = (heightIn + ((1<<level) - 1)) >> level;
+
+    // Remove loop upperbounds for RTL code coverage
+    // Use bit accurate data types on loop iterator
+    WROW: for (maxH y = 0; ; y++) { // Extra iteration to ramp-up window
+      WCOL: for (maxW x = 0; ; x++) {
+        pix = 0;
+        if ((y < height) & (x < width)) {
+          pix = dat_in.read(); // Read streaming interface
+        }
+        win.shift(pix, x, y, width, height);
+
+        if (win.valid(x, y)) { // Write streaming interfaces
+          dx.write(edgeKernel::apply(win.window[1][0], win.window[1][1], win.window[1][2]));
+          dy.write(edgeKernel::apply(win.window[0][1], win.window[1][1], win.window[2][1]));
+        }
+        // programmable width exit condition, ramp-up column included
+        if (x == width) // cast to maxW for RTL code coverage
+          break;
+      }
+      // programmable height exit condition, ramp-up line included
+      if (y == height) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: magnitudeAngle
+  //   Compute the magnitute and angle based on the horizontal and vertical
+  //   derivative results
+#pragma hls_design
+  void magnitudeAngle(ac_channel<gradType> &dx_in,
+                      ac_channel<gradType> &dy_in,
+                      maxW                 &widthIn,
+                      maxH                 &heightIn,
+                      ac_channel<magType>  &magn,
+                      ac_channel<angType>  &angle)
+  {
+    gradType dx, dy;
+    sqType dx_sq;
+    sqType dy_sq;
+    sumType sum; // fixed point integer for sqrt
+    angType at;
+    ac_fixed<magW+7,magW,false> sq_rt; // square-root return type
+    maxW width = (widthIn + ((1<<level) - 1)) >> level;
+    maxH height = (heightIn + ((1<<level) - 1)) >> level;
+
+    MROW: for (maxH y = 0; ; y++) {
+      MCOL: for (maxW x = 0; ; x++) {
+        dx = dx_in.read();
+        dy = dy_in.read();
+        dx_sq = dx * dx;
+        dy_sq = dy * dy;
+        sum = dx_sq + dy_sq;
+        // Catapult's math library piecewise linear implementation of sqrt and atan2
+        ac_math::ac_sqrt_pwl(sum,sq_rt);
+        magn.write(sq_rt.to_uint());
+        ac_math::ac_atan2_cordic((ac_fixed<gradW,gradW>)dy, (ac_fixed<gradW,gradW>)dx, at);
+        angle.write(at);
+        // programmable width exit condition
+        if (x == maxW(width-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      //programmable height exit condition
+      if (y == maxH(height-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Class: EdgeDetect_Pyramid
+//   Three level pyramid, level n is (widthIn/2^n) x (heightIn/2^n) rounded up.
+//   Any size up to imageWidth x imageHeight, odd level widths included
+template <int imageWidth, int imageHeight>
+class EdgeDetect_Pyramid
+{
+  typedef uint8                  pixelType;    // input pixel is 0-255
+  typedef uint9                  magType;      // 9-bit unsigned magnitute result
+  typedef ac_fixed<8,3,true>     angType;      // 3 integer bit, 5 fractional bits for quantized angle -pi to pi
+
+  // Pyramid levels
+  EdgeDetect_PyramidDown<imageWidth,imageHeight,0>  down0;
+  EdgeDetect_PyramidDown<imageWidth,imageHeight,1>  down1;
+  EdgeDetect_PyramidLevel<imageWidth,imageHeight,0> level0;
+  EdgeDetect_PyramidLevel<imageWidth,imageHeight,1> level1;
+  EdgeDetect_PyramidLevel<imageWidth,imageHeight,2> level2;
+
+  // Static interconnect channels (FIFOs) between blocks
+  ac_channel<pixelType>      dat0; // full resolution pixels
+  ac_channel<pixelType>      dat1; // half resolution pixels
+  ac_channel<pixelType>      dat1_thru;
+  ac_channel<pixelType>      dat2; // quarter resolution pixels
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+1>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+1>::val,false> maxH;
+
+  EdgeDetect_Pyramid() {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Builds the half and quarter
+  //   resolution images and the gradients of all three levels.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<pixelType> &dat_in,
+                      maxW                  &widthIn,
+                      maxH                  &heightIn,
+                      ac_channel<magType>   &magn0,
+                      ac_channel<angType>   &angle0,
+                      ac_channel<magType>   &magn1,
+                      ac_channel<angType>   &angle1,
+                      ac_channel<magType>   &magn2,
+                      ac_channel<angType>   &angle2)
+  {
+    down0.run(dat_in, widthIn, heightIn, dat0, dat1);
+    down1.run(dat1, widthIn, heightIn, dat1_thru, dat2);
+    level0.run(dat0, widthIn, heightIn, magn0, angle0);
+    level1.run(dat1_thru, widthIn, heightIn, magn1, angle1);
+    level2.run(dat2, widthIn, heightIn, magn2, angle2);
+  }
+};
+
+#endif
@@ -0,0 +1,57 @@
+#------------------------------------------------------------
+# Sliding Window Walkthrough - Multi-scale gradient pyramid
+#------------------------------------------------------------
+
+# Establish the location of this script and use it to reference all
+# other files in this example
+set sfd [file dirname [info script]]
+  
+# Reset the options to the factory defaults
+options defaults
+options set /Input/CppStandard c++11
+
+project new
+
+flow package require /SCVerify
+flow package option set /SCVerify/USE_CCS_BLOCK true
+flow package option set /SCVerify/INVOKE_ARGS "[file join $sfd image people_gray.bmp] out_algorithm.bmp out_hw.bmp"
+
+solution file add {$MGC_HOME/shared/include/bmpUtil/bmp_io.cpp} -type C++ -exclude true
+solution file add [file join $sfd EdgeDetect_Pyramid_tb.cpp] -type C++
+options set Output/OutputVHDL false
+options set Flows/LowPower/SWITCHING_ACTIVITY_TYPE saif
+
+solution options set /ComponentLibs/SearchPath $sfd -append
+
+go analyze
+directive set -DESIGN_HIERARCHY {{EdgeDetect_Pyramid<1296, 864>} {EdgeDetect_PyramidDown<1296, 864, 0>::run} {EdgeDetect_PyramidDown<1296, 864, 1>::run} {EdgeDetect_PyramidLevel<1296, 864, 0>::windowDerivative} {EdgeDetect_PyramidLevel<1296, 864, 0>::magnitudeAngle} {EdgeDetect_PyramidLevel<1296, 864, 1>::windowDerivative} {EdgeDetect_PyramidLevel<1296, 864, 1>::magnitudeAngle} {EdgeDetect_PyramidLevel<1296, 864, 2>::windowDerivative} {EdgeDetect_PyramidLevel<1296, 864, 2>::magnitudeAngle}}
+go compile
+solution library add nangate-45nm_beh -file {$MGC_HOME/pkgs/siflibs/nangate/nangate-45nm_beh.lib} -- -rtlsyntool OasysRTL
+solution library add ram_1k_16_sp 
+
+go libraries
+directive set -CLOCKS {clk {-CLOCK_PERIOD 3.33 -CLOCK_EDGE rising -CLOCK_UNCERTAINTY 0.0 -CLOCK_HIGH_TIME 1.665 -RESET_SYNC_NAME rst -RESET_ASYNC_NAME arst_n -RESET_KIND sync -RESET_SYNC_ACTIVE high -RESET_ASYNC_ACTIVE low -ENABLE_ACTIVE high}}
+go assembly
+directive set /EdgeDetect_PyramidDown<1296,864,0>/run/core/pair_buf:rsc -BLOCK_SIZE 648
+directive set /EdgeDetect_PyramidDown<1296,864,0>/run/core/DROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_PyramidDown<1296,864,1>/run/core/pair_buf:rsc -BLOCK_SIZE 324
+directive set /EdgeDetect_PyramidDown<1296,864,1>/run/core/DROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_PyramidLevel<1296,864,0>/windowDerivative/core/win.line_buf:rsc -BLOCK_SIZE 648
+directive set /EdgeDetect_PyramidLevel<1296,864,0>/windowDerivative/core/win.line_buf:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
+directive set /EdgeDetect_PyramidLevel<1296,864,0>/windowDerivative/core/WROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_PyramidLevel<1296,864,0>/magnitudeAngle/core/MROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_PyramidLevel<1296,864,0>/magnitudeAngle/core/ac_math::ac_atan2_cordic<9,9,AC_TRN,AC_WRAP,9,9,AC_TRN,AC_WRAP,8,3,AC_TRN,AC_WRAP>:for -UNROLL yes
+directive set /EdgeDetect_PyramidLevel<1296,864,1>/windowDerivative/core/win.line_buf:rsc -BLOCK_SIZE 324
+directive set /EdgeDetect_PyramidLevel<1296,864,1>/windowDerivative/core/win.line_buf:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
+directive set /EdgeDetect_PyramidLevel<1296,864,1>/windowDerivative/core/WROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_PyramidLevel<1296,864,1>/magnitudeAngle/core/MROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_PyramidLevel<1296,864,1>/magnitudeAngle/core/ac_math::ac_atan2_cordic<9,9,AC_TRN,AC_WRAP,9,9,AC_TRN,AC_WRAP,8,3,AC_TRN,AC_WRAP>:for -UNROLL yes
+directive set /EdgeDetect_PyramidLevel<1296,864,2>/windowDerivative/core/win.line_buf:rsc -BLOCK_SIZE 162
+directive set /EdgeDetect_PyramidLevel<1296,864,2>/windowDerivative/core/win.line_buf:rsc -MAP_TO_MODULE ram_1k_16_sp.ram_1k_16_sp
+directive set /EdgeDetect_PyramidLevel<1296,864,2>/windowDerivative/core/WROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_PyramidLevel<1296,864,2>/magnitudeAngle/core/MROW -PIPELINE_INIT_INTERVAL 1
+directive set /EdgeDetect_PyramidLevel<1296,864,2>/magnitudeAngle/core/ac_math::ac_atan2_cordic<9,9,AC_TRN,AC_WRAP,9,9,AC_TRN,AC_WRAP,8,3,AC_TRN,AC_WRAP>:for -UNROLL yes
+directive set /EdgeDetect_Pyramid<1296,864>/widthIn:rsc -MAP_TO_MODULE {[DirectInput]}
+directive set /EdgeDetect_Pyramid<1296,864>/heightIn:rsc -MAP_TO_MODULE {[DirectInput]}
+go architect
+go extract
@@ -0,0 +1,263 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_SlidingWindow.h"
+#include "EdgeDetect_Pyramid.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <mc_scverify.h>
+
+// Host reference for one pyramid step, 2x2 rounded box average with the
+// last column and line of odd sizes replicated
+static void downRef(const unsigned char *in, unsigned char *out, int w, int h)
+{
+  for (int y = 0; y < (h+1)/2; y++) {
+    for (int x = 0; x < (w+1)/2; x++) {
+      int x1 = std::min(2*x+1, w-1);
+      int y1 = std::min(2*y+1, h-1);
+      out[y*((w+1)/2)+x] = (in[2*y*w+2*x] + in[2*y*w+x1] + in[y1*w+2*x] + in[y1*w+x1] + 2) >> 2;
+    }
+  }
+}
+
+// Run the sliding window design, built for lW x lH, on a w x h level image
+// and count the pixels that differ from the pyramid output of that level.
+// The algorithm run on the level image also bounds every pixel, magnitude
+// within 1 and angle within one 1/32 step, as the sliding window design
+// shares the line buffer manager with the pyramid
+template <int lW, int lH>
+static int checkLevel(const unsigned char *img, int w, int h, ac_channel<uint9> &magn, ac_channel<ac_fixed<8,3> > &angle)
+{
+  EdgeDetect_SlidingWindow<lW,lH> *ref = new EdgeDetect_SlidingWindow<lW,lH>;
+  EdgeDetect_Algorithm alg(w,h);
+  typename EdgeDetect_SlidingWindow<lW,lH>::maxW widthIn = w;
+  typename EdgeDetect_SlidingWindow<lW,lH>::maxH heightIn = h;
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn_ref;
+  ac_channel<ac_fixed<8,3> >   angle_ref;
+  double *magn_alg = new double[w*h];
+  double *angle_alg = new double[w*h];
+  for (int i = 0; i < w*h; i++) {
+    dat_in.write(img[i]);
+  }
+  ref->run(dat_in, widthIn, heightIn, magn_ref, angle_ref);
+  alg.run((unsigned char *)img, magn_alg, angle_alg);
+  int err = 0;
+  for (int i = 0; i < w*h; i++) {
+    uint9 m = magn.read();
+    ac_fixed<8,3> a = angle.read();
+    if ((m != magn_ref.read()) || (a != angle_ref.read()) ||
+        (abs(m.to_int() - (int)magn_alg[i]) > 1) || (fabs(a.to_double() - angle_alg[i]) > 1.0/32)) {
+      err++;
+    }
+  }
+  err += magn.size() + angle.size(); // outputs beyond the level
+  delete ref;
+  delete[] magn_alg;
+  delete[] angle_alg;
+  return err;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  typedef EdgeDetect_Pyramid<iW,iH> PyramidT;
+  EdgeDetect_Algorithm             inst0;
+  PyramidT                        *inst1 = new PyramidT;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+  PyramidT::maxW widthIn = iW;
+  PyramidT::maxH heightIn = iH;
+  // Second frame on the same design, widths of the lower levels are odd
+  const int oddW = iW-6;
+  const int oddH = iH-2;
+
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn0, magn1, magn2;
+  ac_channel<ac_fixed<8,3> >   angle0, angle1, angle2;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1->run(dat_in,widthIn,heightIn,magn0,angle0,magn1,angle1,magn2,angle2);
+
+  // Full resolution level against the algorithm
+  float sumErr = 0;
+  float sumAngErr = 0;
+  ac_channel<uint9>            magn0_chk;
+  ac_channel<ac_fixed<8,3> >   angle0_chk;
+  for (int i = 0; i < iH*iW; i++) {
+    uint9 m = magn0.read();
+    ac_fixed<8,3> a = angle0.read();
+    sumErr += abs((int)magn_orig[i] - m.to_int());
+    sumAngErr += fabs(angle_orig[i] - a.to_double());
+    rarray[i] = m;
+    garray[i] = (int)magn_orig[i];
+    magn0_chk.write(m);
+    angle0_chk.write(a);
+  }
+  printf("Level 0: Magnitude: Manhattan norm per pixel %f\n",sumErr/(iH*iW));
+  printf("Level 0: Angle: Manhattan norm per pixel %f\n",sumAngErr/(iH*iW));
+
+  // Every level against the sliding window design run on the host
+  // downscaled image
+  unsigned char *half = new unsigned char[(iH/2)*(iW/2)];
+  unsigned char *quarter = new unsigned char[(iH/4)*(iW/4)];
+  int errors = 0;
+  int err;
+  downRef(dat_in_orig, half, iW, iH);
+  downRef(half, quarter, iW/2, iH/2);
+  errors += err = checkLevel<iW,iH>(dat_in_orig, iW, iH, magn0_chk, angle0_chk);
+  printf("Level 0 (%dx%d) mismatches: %d\n", iW, iH, err);
+  errors += err = checkLevel<iW/2,iH/2>(half, iW/2, iH/2, magn1, angle1);
+  printf("Level 1 (%dx%d) mismatches: %d\n", iW/2, iH/2, err);
+  errors += err = checkLevel<iW/4,iH/4>(quarter, iW/4, iH/4, magn2, angle2);
+  printf("Level 2 (%dx%d) mismatches: %d\n", iW/4, iH/4, err);
+
+  // Frame size that is not a multiple of 4, levels are rounded up
+  const int oddW1 = (oddW+1)/2, oddH1 = (oddH+1)/2;
+  const int oddW2 = (oddW1+1)/2, oddH2 = (oddH1+1)/2;
+  unsigned char *crop = new unsigned char[oddH*oddW];
+  cnt = 0;
+  for (int y = 0; y < oddH; y++) {
+    for (int x = 0; x < oddW; x++) {
+      dat_in.write(dat_in_orig[y*iW+x]);
+      crop[cnt++] = dat_in_orig[y*iW+x];
+    }
+  }
+  widthIn = oddW;
+  heightIn = oddH;
+  inst1->run(dat_in,widthIn,heightIn,magn0,angle0,magn1,angle1,magn2,angle2);
+  downRef(crop, half, oddW, oddH);
+  downRef(half, quarter, oddW1, oddH1);
+  errors += err = checkLevel<iW,iH>(crop, oddW, oddH, magn0, angle0);
+  printf("Level 0 (%dx%d) mismatches: %d\n", oddW, oddH, err);
+  errors += err = checkLevel<iW/2,iH/2>(half, oddW1, oddH1, magn1, angle1);
+  printf("Level 1 (%dx%d) mismatches: %d\n", oddW1, oddH1, err);
+  errors += err = checkLevel<iW/4,iH/4>(quarter, oddW2, oddH2, magn2, angle2);
+  printf("Level 2 (%dx%d) mismatches: %d\n", oddW2, oddH2, err);
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete inst1;
+  delete[] half;
+  delete[] quarter;
+  delete[] crop;
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  if (errors) {
+    cout << "FAILED" << endl;
+    CCS_RETURN(1);
+  }
+  cout << "PASSED" << endl;
+  CCS_RETURN(0);
+}
@@ -146,7 +146,7 @@ private:
         }
 
         // Calculate derivative
-        pix = pix2*kernel[0] + pix1*kernel[1] + pix0*kernel[2];
+        pix = edgeKernel::apply(pix2, pix1, pix0);
 
         if (y != 0) { // Write streaming interfaces
           dat_out.write(pix1); // Pass thru original data
@@ -190,7 +190,7 @@ private:
         pix_buf1 = pix_buf0;
         pix_buf0 = pix0;
         // Calculate derivative
-        pix = pix2*kernel[0] + pix1*kernel[1] + pix0*kernel[2];
+        pix = edgeKernel::apply(pix2, pix1, pix0);
 
         if (x != 0) { // Write streaming interface
           dx.write(pix); // derivative out
@@ -0,0 +1,242 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef _INCLUDED_EDGEDETECT_SLIDINGWINDOW_H_
+#define _INCLUDED_EDGEDETECT_SLIDINGWINDOW_H_
+
+// Revision History
+//    Rev 1 - Coding of edge detection algorithm in C++
+//    Rev 2 - Converted to using bit-accurate data types
+//            Calculated bit growth for internal variables
+//            Quantized angle values for 5 fractional bits -pi to pi
+//    Rev 3 - Switch to using HLSLIBS ac_math library for high performance
+//            math functions.
+//            Add support for verification using SCVerify
+//    Rev 4 - Refinining memory architecture for 1PPC
+//    Rev 5 - Modularized into hierarchy for performance
+//    Rev 6 - Recode to use single-port memories
+//    Rev 7 - Recode to make the design programmable for image size
+//    Rev 8 - Recode to use single-port memories in circular fashion
+//    Rev 9 - Recode both derivatives on a generic KxK sliding window
+//            Optional Gaussian pre-smoothing fused into the same window
+
+#include <ac_fixed.h>
+//This is Catapult's math library implementation, see docs for details
+#include <ac_math/ac_sqrt_pwl.h>
+#include <ac_math/ac_atan2_cordic.h>
+
+// Class for fifo-style hierarchical interconnect objects
+#include <ac_channel.h>
+
+// Include constant kernel definition
+#include "edge_defs.h"
+// Include line buffer manager
+#include "sliding_window.h"
+#include <mc_scverify.h>
+
+// blurSize - 0 for no smoothing, 3 or 5 to smooth the input with a binomial
+//            Gaussian of that size before the derivatives. The blur shares
+//            the derivative line buffers, the window grows to blurSize+2.
+template <int imageWidth, int imageHeight, int blurSize = 0>
+class EdgeDetect_SlidingWindow
+{
+  static_assert((blurSize == 0) || (blurSize == 3) || (blurSize == 5), "blurSize must be 0, 3 or 5");
+
+  // Define some bit-accurate types to use in this model
+  typedef uint8                  pixelType;    // input pixel is 0-255
+  enum {
+    blurShift = blurSize ? 2*(blurSize-1) : 0, // log2 of the Gaussian weight sum
+    winSize = blurSize ? blurSize+2 : 3,       // window for the blur and the 3-tap kernel
+    gradW   = edgeKernel::gradBits(8),         // -255 to 255
+    magW    = edgeKernel::magBits(8)           // 0 to 360
+  };
+  typedef ac_int<gradW,true>     gradType;     // Derivative range derived from the kernel coefficients
+  typedef ac_int<2*gradW,false>  sqType;       // Result of gradType x gradType
+  typedef ac_fixed<2*gradW+1,2*gradW+1,false> sumType; // Result of sqType + sqType fixed pt integer for squareroot
+  typedef ac_int<magW,false>     magType;      // unsigned magnitute result
+  typedef ac_fixed<8,3,true>     angType;      // 3 integer bit, 5 fractional bits for quantized angle -pi to pi
+  typedef ac_int<8+blurShift,false> blurAccType; // Gaussian weighted sum of pixels
+  typedef SlidingWindow<pixelType,winSize,imageWidth> windowType;
+
+  // Static interconnect channels (FIFOs) between blocks
+  ac_channel<gradType>       dy;
+  ac_channel<gradType>       dx;
+
+public:
+  //Compute number of bits for max image size count, used internally and in testbench
+  typedef ac_int<ac::nbits<imageWidth+winSize/2>::val,false> maxW;
+  typedef ac_int<ac::nbits<imageHeight+winSize/2>::val,false> maxH;
+  EdgeDetect_SlidingWindow() {}
+
+  //--------------------------------------------------------------------------
+  // Function: run
+  //   Top interface for data in/out of class. Combines the window derivatives
+  //   and magnitude/angle computation.
+#pragma hls_design interface
+  void CCS_BLOCK(run)(ac_channel<pixelType> &dat_in,
+                      maxW                  &widthIn,
+                      maxH                  &heightIn,
+                      ac_channel<magType>   &magn,
+                      ac_channel<angType>   &angle)
+  {
+    windowDerivative(dat_in, widthIn, heightIn, dx, dy);
+    magnitudeAngle(dx, dy, widthIn, heightIn, magn, angle);
+  }
+
+private:
+  //--------------------------------------------------------------------------
+  // Function: blur
+  //   Gaussian smoothed pixel at window position (r,c), rounded back to
+  //   pixelType. Pass-through when smoothing is disabled.
+  pixelType blur(const windowType &win, int r, int c)
+  {
+    if (blurSize == 0) {
+      return win.window[r][c];
+    }
+    blurAccType acc = (blurShift > 0) ? (1 << (blurShift-1)) : 0; // round to nearest
+#pragma hls_unroll yes
+    for (int i = 0; i < (blurSize ? blurSize : 1); i++) {
+#pragma hls_unroll yes
+      for (int j = 0; j < (blurSize ? blurSize : 1); j++) {
+        acc += edgeBinomial(blurSize-1, i) * edgeBinomial(blurSize-1, j) *
+               win.window[r-blurSize/2+i][c-blurSize/2+j];
+      }
+    }
+    return acc >> blurShift;
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: windowDerivative
+  //   Compute the horizontal and vertical derivatives on the center row and
+  //   column of a 3x3 window of the (optionally smoothed) input data
+#pragma hls_design
+  void windowDerivative(ac_channel<pixelType> &dat_in,
+                        maxW                  &widthIn,
+                        maxH                  &heightIn,
+                        ac_channel<gradType>  &dx,
+                        ac_channel<gradType>  &dy)
+  {
+    // Line buffers and window registers
+    windowType win;
+    pixelType pix;
+    pixelType up, down, left, right, center; // derivative taps
+    enum { mid = winSize/2 };
+
+    // Remove loop upperbounds for RTL code coverage
+    // Use bit accurate data types on loop iterator
+    WROW: for (maxH y = 0; ; y++) { // Extra iterations to ramp-up window
+      WCOL: for (maxW x = 0; ; x++) {
+        pix = 0;
+        if ((y < heightIn) & (x < widthIn)) {
+          pix = dat_in.read(); // Read streaming interface
+        }
+        win.shift(pix, x, y, widthIn, heightIn);
+
+        if (win.valid(x, y)) { // Write streaming interfaces
+          center = blur(win, mid, mid);
+          up     = blur(win, mid-1, mid);
+          down   = blur(win, mid+1, mid);
+          left   = blur(win, mid, mid-1);
+          right  = blur(win, mid, mid+1);
+          if (blurSize > 0) {
+            // Replicate the smoothed border, the window only replicates input pixels
+            if (y == mid) {
+              up = center; // top boundary
+            }
+            if (y == maxH(heightIn+mid-1)) {
+              down = center; // bottom boundary
+            }
+            if (x == mid) {
+              left = center; // left boundary
+            }
+            if (x == maxW(widthIn+mid-1)) {
+              right = center; // right boundary
+            }
+          }
+          // Calculate derivatives
+          dx.write(edgeKernel::apply(left, center, right));
+          dy.write(edgeKernel::apply(up, center, down));
+        }
+        // programmable width exit condition, ramp-up columns included
+        if (x == maxW(widthIn+mid-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      // programmable height exit condition, ramp-up lines included
+      if (y == maxH(heightIn+mid-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: magnitudeAngle
+  //   Compute the magnitute and angle based on the horizontal and vertical
+  //   derivative results
+#pragma hls_design
+  void magnitudeAngle(ac_channel<gradType> &dx_in,
+                      ac_channel<gradType> &dy_in,
+                      maxW                 &widthIn,
+                      maxH                 &heightIn,
+                      ac_channel<magType>  &magn,
+                      ac_channel<angType>  &angle)
+  {
+    gradType dx, dy;
+    sqType dx_sq;
+    sqType dy_sq;
+    sumType sum; // fixed point integer for sqrt
+    angType at;
+    ac_fixed<magW+7,magW,false> sq_rt; // square-root return type
+
+    MROW: for (maxH y = 0; ; y++) {
+      MCOL: for (maxW x = 0; ; x++) {
+        dx = dx_in.read();
+        dy = dy_in.read();
+        dx_sq = dx * dx;
+        dy_sq = dy * dy;
+        sum = dx_sq + dy_sq;
+        // Catapult's math library piecewise linear implementation of sqrt and atan2
+        ac_math::ac_sqrt_pwl(sum,sq_rt);
+        magn.write(sq_rt.to_uint());
+        ac_math::ac_atan2_cordic((ac_fixed<gradW,gradW>)dy, (ac_fixed<gradW,gradW>)dx, at);
+        angle.write(at);
+        // programmable width exit condition
+        if (x == maxW(widthIn-1)) // cast to maxW for RTL code coverage
+          break;
+      }
+      //programmable height exit condition
+      if (y == maxH(heightIn-1)) // cast to maxH for RTL code coverage
+        break;
+    }
+  }
+
+};
+
+#endif
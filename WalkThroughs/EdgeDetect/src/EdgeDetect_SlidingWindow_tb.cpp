@@ -0,0 +1,260 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+#include "EdgeDetect_Algorithm.h"
+#include "EdgeDetect_SlidingWindow.h"
+
+#include "bmpUtil/bmp_io.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <mc_scverify.h>
+
+// Host reference for the fused smoothing, binomial Gaussian of size n with
+// replicated borders, rounded to nearest
+static void gaussRef(const unsigned char *in, unsigned char *out, int w, int h, int n)
+{
+  int tap[5] = { 1, 1, 1, 1, 1 };
+  for (int k = 1; k < n-1; k++) {
+    for (int i = k; i > 0; i--) {
+      tap[i] += tap[i-1];
+    }
+  }
+  int shift = 2*(n-1);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      int acc = 1 << (shift-1);
+      for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+          int yy = std::min(std::max(y-n/2+i, 0), h-1);
+          int xx = std::min(std::max(x-n/2+j, 0), w-1);
+          acc += tap[i] * tap[j] * in[yy*w+xx];
+        }
+      }
+      out[y*w+x] = acc >> shift;
+    }
+  }
+}
+
+// Run a smoothed variant and compare against the algorithm on the host
+// smoothed image
+template <int iW, int iH, int blurSize>
+static void checkBlur(const unsigned char *img)
+{
+  EdgeDetect_Algorithm                         alg;
+  EdgeDetect_SlidingWindow<iW,iH,blurSize>     dut;
+  typename EdgeDetect_SlidingWindow<iW,iH,blurSize>::maxW widthIn = iW;
+  typename EdgeDetect_SlidingWindow<iW,iH,blurSize>::maxH heightIn = iH;
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+
+  unsigned char *smooth = new unsigned char[iH*iW];
+  double *magn_ref = new double[iH*iW];
+  double *angle_ref = new double[iH*iW];
+  gaussRef(img, smooth, iW, iH, blurSize);
+  alg.run(smooth, magn_ref, angle_ref);
+
+  for (int i = 0; i < iH*iW; i++) {
+    dat_in.write(img[i]);
+  }
+  dut.run(dat_in, widthIn, heightIn, magn, angle);
+
+  float sumErr = 0;
+  float sumAngErr = 0;
+  for (int i = 0; i < iH*iW; i++) {
+    sumErr += abs((int)magn_ref[i] - (int)magn.read());
+    sumAngErr += abs((float)angle_ref[i] - (float)angle.read().to_double());
+  }
+  printf("%dx%d Gaussian smoothing\n", blurSize, blurSize);
+  printf("Magnitude: Manhattan norm per pixel %f\n",sumErr/(iH*iW));
+  printf("Angle: Manhattan norm per pixel %f\n",sumAngErr/(iH*iW));
+
+  delete[] smooth;
+  delete[] magn_ref;
+  delete[] angle_ref;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  const int iW = 1296;
+  const int iH = 864;
+  EdgeDetect_Algorithm            inst0;
+  EdgeDetect_SlidingWindow<iW,iH>    inst1;
+
+  unsigned long int width = iW;
+  long int height         = iH;
+
+
+  EdgeDetect_SlidingWindow<iW,iH>::maxW widthIn = iW;
+  EdgeDetect_SlidingWindow<iW,iH>::maxH heightIn = iH;
+  unsigned char *rarray = new unsigned char[iH*iW];
+  unsigned char *garray = new unsigned char[iH*iW];
+  unsigned char *barray = new unsigned char[iH*iW];
+
+  cout << "Loading Input File" << endl;
+
+  if (argc < 3) {
+    cout << "Usage: " << argv[0] << " <inputbmp> <outputbmp_alg> <outputbmp_ba>" << endl;
+    CCS_RETURN(-1);
+  }
+
+  std::string bmpIn(argv[1]);  // input bitmap file
+  std::string bmpAlg(argv[2]); // output bitmap (algorithm)
+  std::string bmpBA(argv[3]);  // output bitmap (bit-accurate)
+
+  bmp_read((char*)bmpIn.c_str(), &width, &height, &rarray, &garray, &barray);
+  assert(width==iW);
+  assert(height==iH);
+
+#ifdef DEBUG
+  std::string cmd;
+  cmd = "display ";
+  cmd.append(bmpIn.c_str());
+  std::cout << "Display input image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  ac_channel<uint8>            dat_in;
+  ac_channel<uint9>            magn;
+  ac_channel<ac_fixed<8,3> >   angle;
+
+  unsigned char *dat_in_orig = new unsigned char[iH*iW];;
+  double *magn_orig = new double[iH*iW];
+  double *angle_orig = new double[iH*iW];
+
+  unsigned  cnt = 0;
+  for (int y = 0; y < iH; y++) {
+    for (int x = 0; x < iW; x++) {
+      dat_in.write(rarray[cnt]); // just using red component (pseudo monochrome)
+      dat_in_orig[cnt] = rarray[cnt];
+      cnt++;
+    }
+  }
+
+  cout << "Running" << endl;
+
+  inst0.run(dat_in_orig,magn_orig,angle_orig);
+  inst1.run(dat_in,widthIn,heightIn,magn,angle);
+
+  cnt = 0;
+  float sumErr = 0;
+  float sumAngErr = 0;
+  for (int y = 0; y < heightIn; y++) {
+    for (int x = 0; x < iW; x++) {
+      int hw = magn.read();
+      int alg = (int)*(magn_orig+cnt);
+      int diff = alg-hw;
+      int adiff = abs(diff);
+      sumErr += adiff;
+      float angO = (double)*(angle_orig+cnt);
+      float angHw = angle.read().to_double();
+      float angAdiff = abs(angO-angHw);
+      sumAngErr += angAdiff;
+      cnt++;
+      rarray[cnt] = hw;   // repurposing 'red' array to the bit-accurate monochrome edge-detect output
+      garray[cnt] = alg;  // repurposing 'green' array to the original algorithmic edge-detect output
+    }
+  }
+
+  printf("Magnitude: Manhattan norm per pixel %f\n",sumErr/(iH*iW));
+  printf("Angle: Manhattan norm per pixel %f\n",sumAngErr/(iH*iW));
+
+  // Check a 5x5 window against direct indexing with clamped coordinates
+  const int K = 5;
+  SlidingWindow<uint8,K,iW> *win5 = new SlidingWindow<uint8,K,iW>;
+  unsigned long winErr = 0;
+  for (int y = 0; y < iH+K/2; y++) {
+    for (int x = 0; x < iW+K/2; x++) {
+      uint8 pix = 0;
+      if ((y < iH) & (x < iW)) {
+        pix = dat_in_orig[y*iW+x];
+      }
+      win5->shift(pix, x, y, (int)iW, (int)iH);
+      if (win5->valid(x, y)) {
+        for (int r = 0; r < K; r++) {
+          for (int c = 0; c < K; c++) {
+            int yy = std::min(std::max(y-K+1+r, 0), iH-1);
+            int xx = std::min(std::max(x-K+1+c, 0), iW-1);
+            if (win5->window[r][c] != dat_in_orig[yy*iW+xx]) {
+              winErr++;
+            }
+          }
+        }
+      }
+    }
+  }
+  delete win5;
+  printf("5x5 window mismatches %lu\n", winErr);
+
+  // Smoothing fused into the derivative window
+  checkBlur<iW,iH,3>(dat_in_orig);
+  checkBlur<iW,iH,5>(dat_in_orig);
+
+  cout << "Writing algorithmic bitmap output to: " << bmpAlg << endl;
+  bmp_24_write((char*)bmpAlg.c_str(), iW,  iH, garray, garray, garray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpAlg.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  cout << "Writing bit-accurate bitmap output to: " << bmpBA << endl;
+  bmp_24_write((char*)bmpBA.c_str(), iW,  iH, rarray, rarray, rarray);
+
+#ifdef DEBUG
+  cmd = "display ";
+  cmd.append(bmpBA.c_str());
+  std::cout << "Display output image file using command: " << cmd << endl;
+  std::system(cmd.c_str());
+#endif
+
+  delete (dat_in_orig);
+  delete (magn_orig);
+  delete (angle_orig);
+  delete (rarray);
+  delete (garray);
+  delete (barray);
+
+  cout << "Finished" << endl;
+
+  CCS_RETURN(0);
+}
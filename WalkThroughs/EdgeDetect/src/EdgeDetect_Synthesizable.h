@@ -98,9 +98,9 @@ public:
     VROW: for (int y = 0; y < imageHeight; y++) {
       VCOL: for (int x = 0; x < imageWidth; x++) {
         dy[y][x] =
-          dat_in[clip(y - 1, imageHeight-1)][x] * kernel[0] +
-          dat_in[y][x]                          * kernel[1] +
-          dat_in[clip(y + 1, imageHeight-1)][x] * kernel[2];
+          edgeKernel::apply(dat_in[clip(y - 1, imageHeight-1)][x],
+                            dat_in[y][x],
+                            dat_in[clip(y + 1, imageHeight-1)][x]);
       }
     }
   }
@@ -114,9 +114,9 @@ public:
     HROW: for (int y = 0; y < imageHeight; y++) {
       HCOL: for (int x = 0; x < imageWidth; x++) {
         dx[y][x] =
-          dat_in[y][clip(x - 1, imageWidth-1)] * kernel[0] +
-          dat_in[y][x]                         * kernel[1] +
-          dat_in[y][clip(x + 1, imageWidth-1)] * kernel[2];
+          edgeKernel::apply(dat_in[y][clip(x - 1, imageWidth-1)],
+                            dat_in[y][x],
+                            dat_in[y][clip(x + 1, imageWidth-1)]);
       }
     }
   }
@@ -32,5 +32,127 @@
  *************************************************************************/
 #ifndef __EDGE_DEFS__
 #define __EDGE_DEFS__
-const int kernel[3] = {1, 0, -1};
+
+//----------------------------------------------------------------------------
+// Function: edgeBits
+//   Number of bits needed to hold the unsigned value v
+constexpr int edgeBits(long long v)
+{
+  return (v > 1) ? 1 + edgeBits(v >> 1) : 1;
+}
+
+//----------------------------------------------------------------------------
+// Function: edgeSqrt
+//   Integer square root, bisection between lo and hi
+constexpr long long edgeSqrt(long long v, long long lo = 0, long long hi = 1LL << 31)
+{
+  return (lo + 1 >= hi) ? lo :
+         ((((lo + hi) / 2) * ((lo + hi) / 2) <= v) ? edgeSqrt(v, (lo + hi) / 2, hi)
+                                                   : edgeSqrt(v, lo, (lo + hi) / 2));
+}
+
+//----------------------------------------------------------------------------
+// Function: edgeBinomial
+//   Binomial coefficient n choose k, taps of the binomial Gaussian kernel
+constexpr int edgeBinomial(int n, int k)
+{
+  return (k <= 0 || k >= n) ? 1 : edgeBinomial(n-1, k-1) + edgeBinomial(n-1, k);
+}
+
+//----------------------------------------------------------------------------
+// Enum: edgeOutputs
+//   Outputs built by a design or host model. Single output configurations
+//   drop the other output and all of its arithmetic.
+enum edgeOutputs {
+  edgeMagnitude = 1,
+  edgeAngle     = 2,
+  edgeBoth      = edgeMagnitude | edgeAngle
+};
+
+//----------------------------------------------------------------------------
+// Struct: kernelTap
+//   Multiply a pixel by a compile-time coefficient. Zero taps vanish and
+//   +-1 taps reduce to a pass-through or a negate.
+template <int c>
+struct kernelTap
+{
+  template <typename T>
+  static auto apply(T pix) -> decltype(pix * c) { return pix * c; }
+};
+
+template <>
+struct kernelTap<0>
+{
+  template <typename T>
+  static int apply(T) { return 0; }
+};
+
+template <>
+struct kernelTap<1>
+{
+  template <typename T>
+  static T apply(T pix) { return pix; }
+};
+
+template <>
+struct kernelTap<-1>
+{
+  template <typename T>
+  static auto apply(T pix) -> decltype(-pix) { return -pix; }
+};
+
+//----------------------------------------------------------------------------
+// Struct: derivKernel
+//   Constant 3-tap derivative kernel {k0, k1, k2}, applied as
+//   pix2*k0 + pix1*k1 + pix0*k2. Also derives the bit growth of the
+//   derivative and magnitude for unsigned pixels of a given width.
+template <int k0, int k1, int k2>
+struct derivKernel
+{
+  enum {
+    posSum = (k0 > 0 ? k0 : 0) + (k1 > 0 ? k1 : 0) + (k2 > 0 ? k2 : 0),  // sum of positive coefficients
+    negSum = (k0 < 0 ? -k0 : 0) + (k1 < 0 ? -k1 : 0) + (k2 < 0 ? -k2 : 0) // sum of negative coefficients
+  };
+
+  // Largest derivative magnitude
+  static constexpr long long gradMax(int pixelBits)
+  {
+    return ((1LL << pixelBits) - 1) * (posSum > negSum ? posSum : negSum);
+  }
+
+  // Signed derivative width, range -(2^pixelBits-1)*negSum to (2^pixelBits-1)*posSum
+  static constexpr int gradBits(int pixelBits)
+  {
+    return 1 + (edgeBits(((1LL << pixelBits) - 1) * posSum) > edgeBits(((1LL << pixelBits) - 1) * negSum - 1) ?
+                edgeBits(((1LL << pixelBits) - 1) * posSum) : edgeBits(((1LL << pixelBits) - 1) * negSum - 1));
+  }
+
+  // Unsigned magnitude width, sqrt(dx^2 + dy^2) of the largest derivatives
+  static constexpr int magBits(int pixelBits)
+  {
+    return edgeBits(edgeSqrt(2 * gradMax(pixelBits) * gradMax(pixelBits)));
+  }
+
+  template <typename T>
+  static auto apply(T pix2, T pix1, T pix0)
+    -> decltype(kernelTap<k0>::apply(pix2) + kernelTap<k1>::apply(pix1) + kernelTap<k2>::apply(pix0))
+  {
+    return kernelTap<k0>::apply(pix2) + kernelTap<k1>::apply(pix1) + kernelTap<k2>::apply(pix0);
+  }
+
+  // Run time coefficients of the kernel, none for a constant kernel. A
+  // programmable kernel (progKernel in EdgeDetect_ProgKernel.h) carries its
+  // coefficients here and the designs pass them to apply.
+  struct coefs {};
+
+  template <typename T>
+  static auto apply(const coefs &, T pix2, T pix1, T pix0) -> decltype(apply(pix2, pix1, pix0))
+  {
+    return apply(pix2, pix1, pix0);
+  }
+};
+
+// Derivative kernel used by all variants
+typedef derivKernel<1, 0, -1> edgeKernel;
+
 #endif
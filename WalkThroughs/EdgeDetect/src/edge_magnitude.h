@@ -0,0 +1,210 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef __EDGE_MAGNITUDE__
+#define __EDGE_MAGNITUDE__
+
+#include <ac_fixed.h>
+//This is Catapult's math library implementation, see docs for details
+#include <ac_math/ac_sqrt_pwl.h>
+
+//----------------------------------------------------------------------------
+// Gradient magnitude policies. Each computes the unsigned magWidth-bit
+// magnitude of the signed gradWidth-bit derivatives dx and dy. The cheap
+// norms need no squares and no square root, results that do not fit in
+// magWidth bits saturate. Policies with hasAngle set also produce the
+// gradient angle with vector(), and replace the separate atan2.
+
+//----------------------------------------------------------------------------
+// Function: edgeAbs
+//   Absolute value of a signed derivative
+template <int gradWidth>
+ac_int<gradWidth,false> edgeAbs(ac_int<gradWidth,true> d)
+{
+  ac_int<gradWidth,false> a = d;
+  if (d < 0) {
+    a = -d;
+  }
+  return a;
+}
+
+//----------------------------------------------------------------------------
+// Struct: magPolicy
+//   Defaults shared by the magnitude only policies
+struct magPolicy
+{
+  enum { hasAngle = 0 };
+
+  template <int gradWidth, int magWidth, class angT>
+  static void vector(ac_int<gradWidth,true>, ac_int<gradWidth,true>, ac_int<magWidth,false> &, angT &) {}
+};
+
+//----------------------------------------------------------------------------
+// Struct: magSqrt
+//   sqrt(dx^2 + dy^2) using the piecewise linear square root
+struct magSqrt : magPolicy
+{
+  template <int gradWidth, int magWidth>
+  static ac_int<magWidth,false> apply(ac_int<gradWidth,true> dx, ac_int<gradWidth,true> dy)
+  {
+    ac_int<2*gradWidth,false> dx_sq = dx * dx;
+    ac_int<2*gradWidth,false> dy_sq = dy * dy;
+    ac_fixed<2*gradWidth+1,2*gradWidth+1,false> sum = dx_sq + dy_sq; // fixed pt integer for squareroot
+    ac_fixed<magWidth+7,magWidth,false> sq_rt; // square-root return type
+    ac_math::ac_sqrt_pwl(sum,sq_rt);
+    return sq_rt.to_uint();
+  }
+};
+
+//----------------------------------------------------------------------------
+// Struct: magL1
+//   |dx| + |dy|, overestimates by up to 41%
+struct magL1 : magPolicy
+{
+  template <int gradWidth, int magWidth>
+  static ac_int<magWidth,false> apply(ac_int<gradWidth,true> dx, ac_int<gradWidth,true> dy)
+  {
+    ac_int<gradWidth,false> ax = edgeAbs(dx);
+    ac_int<gradWidth,false> ay = edgeAbs(dy);
+    ac_int<gradWidth+1,false> sum = ax + ay;
+    const ac_int<magWidth,false> magMax = -1;
+    return (sum > magMax) ? magMax : ac_int<magWidth,false>(sum);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Struct: magLinf
+//   max(|dx|, |dy|), underestimates by up to 29%
+struct magLinf : magPolicy
+{
+  template <int gradWidth, int magWidth>
+  static ac_int<magWidth,false> apply(ac_int<gradWidth,true> dx, ac_int<gradWidth,true> dy)
+  {
+    ac_int<gradWidth,false> ax = edgeAbs(dx);
+    ac_int<gradWidth,false> ay = edgeAbs(dy);
+    return (ax > ay) ? ax : ay;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Struct: magAlphaMaxBetaMin
+//   15/16*max(|dx|,|dy|) + 15/32*min(|dx|,|dy|), rounded, within 6.25% of
+//   the exact magnitude. Shifts and adds only.
+struct magAlphaMaxBetaMin : magPolicy
+{
+  template <int gradWidth, int magWidth>
+  static ac_int<magWidth,false> apply(ac_int<gradWidth,true> dx, ac_int<gradWidth,true> dy)
+  {
+    ac_int<gradWidth,false> ax = edgeAbs(dx);
+    ac_int<gradWidth,false> ay = edgeAbs(dy);
+    // Widened before shifting, an ac_int shift keeps the operand width
+    ac_int<gradWidth+6,false> mx = (ax > ay) ? ax : ay;
+    ac_int<gradWidth+6,false> mn = (ax > ay) ? ay : ax;
+    // (30*max + 15*min + 16) / 32
+    ac_int<gradWidth+6,false> acc = (mx << 5) - (mx << 1) + (mn << 4) - mn + 16;
+    ac_int<gradWidth+1,false> est = acc >> 5;
+    const ac_int<magWidth,false> magMax = -1;
+    return (est > magMax) ? magMax : ac_int<magWidth,false>(est);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Struct: magCordic
+//   Vectoring mode CORDIC, rotates (dx,dy) onto the x axis in iterations
+//   shift-add steps. The accumulated rotation is the angle, the final x is
+//   the magnitude scaled by the CORDIC gain (1.647), which is compensated
+//   with one constant multiply. No squares and no square root.
+template <int iterations = 10>
+struct magCordic
+{
+  static_assert((iterations >= 6) && (iterations <= 16), "magCordic iterations must be 6 to 16");
+
+  enum { hasAngle = 1 };
+
+  template <int gradWidth, int magWidth, class angT>
+  static void vector(ac_int<gradWidth,true> dx, ac_int<gradWidth,true> dy, ac_int<magWidth,false> &mag, angT &at)
+  {
+    // atan(2^-i)
+    static const ac_fixed<16,0,false> atanTab[16] = {
+      0.785398163, 0.463647609, 0.244978663, 0.124354995, 0.062418810, 0.031239833, 0.015623729, 0.007812341,
+      0.003906230, 0.001953123, 0.000976562, 0.000488281, 0.000244141, 0.000122070, 0.000061035, 0.000030518
+    };
+    const ac_fixed<14,0,false> invGain = 0.607252935; // 1/prod(sqrt(1+2^-2i))
+    const ac_fixed<16,3,true> pi = 3.14159265358979;
+    // |(x,y)| grows up to sqrt(2)*1.647 times the largest derivative
+    typedef ac_fixed<gradWidth+2+iterations,gradWidth+2,true> vecType;
+    vecType x = dx, y = dy, xs;
+    ac_fixed<16,3,true> z = 0;
+
+    // Rotate the left half plane by pi so the iterations converge
+    if (dx < 0) {
+      x = -x;
+      y = -y;
+      z = (dy < 0) ? ac_fixed<16,3,true>(-pi) : pi;
+    }
+#pragma hls_unroll yes
+    CORDIC: for (int i = 0; i < iterations; i++) {
+      xs = x;
+      if (y < 0) {
+        x -= y >> i;
+        y += xs >> i;
+        z -= atanTab[i];
+      } else {
+        x += y >> i;
+        y -= xs >> i;
+        z += atanTab[i];
+      }
+    }
+    ac_fixed<gradWidth+2,gradWidth+2,false> m = x * invGain;
+    const ac_int<magWidth,false> magMax = -1;
+    mag = (m > magMax) ? magMax : ac_int<magWidth,false>(m.to_uint());
+    at = z;
+    // Exact angles on the axes, where the residual rotation of the
+    // iterations could truncate to the next lower angle
+    if (dy == 0) {
+      at = (dx < 0) ? pi : ac_fixed<16,3,true>(0); // atan2(0,0) is 0
+    } else if (dx == 0) {
+      at = (dy < 0) ? ac_fixed<16,3,true>(-pi/2) : ac_fixed<16,3,true>(pi/2);
+    }
+  }
+
+  template <int gradWidth, int magWidth>
+  static ac_int<magWidth,false> apply(ac_int<gradWidth,true> dx, ac_int<gradWidth,true> dy)
+  {
+    ac_int<magWidth,false> mag;
+    ac_fixed<8,3,true> at;
+    vector<gradWidth,magWidth>(dx, dy, mag, at);
+    return mag;
+  }
+};
+
+#endif
@@ -0,0 +1,165 @@
+/**************************************************************************
+ *                                                                        *
+ *  Edge Detect Design Walkthrough for HLS                                *
+ *                                                                        *
+ *  Software Version: 1.0                                                 *
+ *                                                                        *
+ *  Release Date    : Tue Jan 14 15:40:43 PST 2020                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 1.0.0                                               *
+ *                                                                        *
+ *  Copyright 2020, Mentor Graphics Corporation,                          *
+ *                                                                        *
+ *  All Rights Reserved.                                                  *
+ *  
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      * 
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   * 
+ *  distributed under the License is distributed on an "AS IS" BASIS,     * 
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              * 
+ *  See the License for the specific language governing permissions and   * 
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+#ifndef __SLIDING_WINDOW__
+#define __SLIDING_WINDOW__
+
+#include <ac_int.h>
+
+//----------------------------------------------------------------------------
+// Class: SlidingWindow
+//   Line buffer manager presenting a KxK window of a raster scanned image,
+//   one window per call. K-1 single-port line buffers hold the previous
+//   lines two pixels per word. All of them are read on even columns, and
+//   the current line is written over the oldest one on odd columns. The
+//   last word of an odd width line is written on the column after the
+//   line. The buffers rotate after the last column of each line, so no
+//   line is ever copied. Image edges are handled by replicating the border
+//   pixels.
+//
+//   The caller scans y from 0 to height+K/2-1 and x from 0 to width+K/2-1,
+//   reads a new pixel while (x < width) & (y < height), and calls shift().
+//   Once valid() is true, window[r][c] is centered on pixel
+//   (x-K/2, y-K/2), with window[0][0] at the top-left. Any width up to
+//   maxWidth is supported.
+template <typename T, int K, int maxWidth>
+class SlidingWindow
+{
+  static_assert((K >= 3) && (K & 1), "SlidingWindow size must be odd and at least 3");
+
+  enum { lines = K-1, half = K/2, pixW = T::width };
+
+  typedef ac_int<2*pixW,false> wordType; // two pixels packed
+
+  wordType line_buf[lines][(maxWidth+1)/2]; // Line buffers, mapped to RAM
+  wordType rdbuf[lines];                // read caches, one per line buffer
+  wordType wrbuf;                       // write cache for the current line
+  T        cols[K][K];                  // column shift register
+  ac_int<ac::nbits<lines>::val,false> head; // line buffer holding the oldest line
+
+public:
+  T window[K][K]; // Window with border replication applied
+
+  SlidingWindow():head(0) {}
+
+  //--------------------------------------------------------------------------
+  // Function: valid
+  //   True once the window is centered on a pixel of the image
+  template <typename xT, typename yT>
+  static bool valid(xT x, yT y)
+  {
+    return (x >= half) & (y >= half);
+  }
+
+  //--------------------------------------------------------------------------
+  // Function: shift
+  //   Advance the window by one column. pixIn is ignored outside the image.
+  template <typename xT, typename yT>
+  void shift(T pixIn, xT x, yT y, xT width, yT height)
+  {
+    T col[K];
+
+    // Write data cache, lower pixel on even columns, upper on odd
+    if ((x&1) == 0) {
+      wrbuf.set_slc(0,pixIn);
+    } else {
+      wrbuf.set_slc(pixW,pixIn);
+    }
+    if ((x < width) & ((x&1) == 0)) {
+      // Read all line buffers into the read caches on even columns
+#pragma hls_unroll yes
+      for (int i = 0; i < lines; i++) {
+        rdbuf[i] = line_buf[i][x/2];
+      }
+    } else if (((x&1) == 1) & (x <= width) & (y < height)) {
+      // Only the oldest line is overwritten, on odd columns. x == width is
+      // the column after an odd width line, its upper pixel is unused
+      line_buf[head][x/2] = wrbuf;
+    }
+
+    // Column from oldest line (top) to current line (bottom), line i
+    // lives in buffer (head+i) mod K-1
+#pragma hls_unroll yes
+    for (int i = 0; i < lines; i++) {
+      int b = (head + i < lines) ? head + i : head + i - lines;
+      col[i] = ((x&1)==0) ? rdbuf[b].template slc<pixW>(0) : rdbuf[b].template slc<pixW>(pixW);
+    }
+    col[K-1] = pixIn;
+
+    // Top and bottom boundaries, replicate the outermost image line
+#pragma hls_unroll yes
+    for (int i = half-1; i >= 0; i--) {
+      if (y + i < K-1) {
+        col[i] = col[i+1];
+      }
+    }
+#pragma hls_unroll yes
+    for (int i = half+1; i < K; i++) {
+      if (y + i >= height + K-1) {
+        col[i] = col[i-1];
+      }
+    }
+
+    // Shift the new column in on the right
+#pragma hls_unroll yes
+    for (int r = 0; r < K; r++) {
+#pragma hls_unroll yes
+      for (int c = 0; c < K-1; c++) {
+        cols[r][c] = cols[r][c+1];
+      }
+      cols[r][K-1] = col[r];
+    }
+
+    // Left and right boundaries, replicate the outermost image column
+#pragma hls_unroll yes
+    for (int r = 0; r < K; r++) {
+      window[r][half] = cols[r][half];
+#pragma hls_unroll yes
+      for (int c = half-1; c >= 0; c--) {
+        window[r][c] = (x + c < K-1) ? window[r][c+1] : cols[r][c];
+      }
+#pragma hls_unroll yes
+      for (int c = half+1; c < K; c++) {
+        window[r][c] = (x + c >= width + K-1) ? window[r][c-1] : cols[r][c];
+      }
+    }
+
+    // Rotate the line buffers after the last column of every line, ramp-up
+    // lines included. The columns after the image only feed replicated
+    // window columns, so they may still see the old order
+    if (x == width+half-1) {
+      head = (head == lines-1) ? 0 : head + 1;
+    }
+  }
+};
+
+#endif